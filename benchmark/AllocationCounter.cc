@@ -0,0 +1,76 @@
+#include "AllocationCounter.h"
+
+#include <malloc.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<long long> allocationCount {0};
+std::atomic<long long> liveByteCount {0};
+
+void *countedAlloc(std::size_t size) noexcept
+{
+    void *ptr = std::malloc(size ? size : 1);
+    if (ptr) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        liveByteCount.fetch_add(malloc_usable_size(ptr), std::memory_order_relaxed);
+    }
+    return ptr;
+}
+
+void countedFree(void *ptr) noexcept
+{
+    if (!ptr)
+        return;
+    liveByteCount.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+    std::free(ptr);
+}
+
+} // namespace
+
+namespace benchmark {
+
+AllocationSnapshot allocationSnapshot()
+{
+    AllocationSnapshot snapshot;
+    snapshot.allocations = allocationCount.load(std::memory_order_relaxed);
+    snapshot.liveBytes = liveByteCount.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+} // namespace benchmark
+
+// Replacements of the global allocation functions. malloc_usable_size keeps
+// the live byte count exact without a size header, so the sized and unsized
+// delete forms can share one implementation.
+
+void *operator new(std::size_t size)
+{
+    if (void *ptr = countedAlloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    return countedAlloc(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return countedAlloc(size);
+}
+
+void operator delete(void *ptr) noexcept { countedFree(ptr); }
+void operator delete[](void *ptr) noexcept { countedFree(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { countedFree(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { countedFree(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept { countedFree(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept { countedFree(ptr); }
@@ -0,0 +1,19 @@
+#ifndef BENCHMARK_ALLOCATIONCOUNTER_H
+#define BENCHMARK_ALLOCATIONCOUNTER_H
+
+namespace benchmark {
+
+/**
+ * Heap activity seen through the global operator new/delete, which
+ * AllocationCounter.cc replaces. Only linked into the benchmark executable.
+ */
+struct AllocationSnapshot {
+    long long allocations = 0;  //!< operator new calls so far.
+    long long liveBytes = 0;    //!< Usable bytes currently allocated through operator new.
+};
+
+AllocationSnapshot allocationSnapshot();
+
+} // namespace benchmark
+
+#endif
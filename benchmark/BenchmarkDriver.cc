@@ -0,0 +1,301 @@
+#include <omnetpp.h>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include "AllocationCounter.h"
+#include "garbage_collection/WallClock.h"
+#include "garbage_collection/messages_m.h"
+
+using namespace omnetpp;
+using namespace garbage_collection;
+using namespace benchmark;
+
+/**
+ * Records the heap at two points in the network's life: when it is
+ * constructed and when it is initialized. Placed between the module groups
+ * of HandlerBenchmark, the difference between neighbouring probes is the
+ * heap a group took while being built and initialized.
+ */
+class HeapProbe : public cSimpleModule {
+  public:
+    HeapProbe() : constructed(allocationSnapshot()) {}
+
+    const AllocationSnapshot &atConstruction() const { return constructed; }
+    const AllocationSnapshot &atInitialization() const { return initialized; }
+
+  protected:
+    void initialize() override
+    {
+        initialized = allocationSnapshot();
+    }
+
+    void handleMessage(cMessage *msg) override
+    {
+        delete msg;
+    }
+
+  private:
+    AllocationSnapshot constructed;
+    AllocationSnapshot initialized;
+};
+Define_Module(HeapProbe);
+
+/**
+ * Stands in for every peer of the collector, the cans and the cloud, and
+ * drives one synthetic stream per phase through their handleMessage.
+ *
+ * Phases run at consecutive whole seconds of simulated time. All links have
+ * zero delay, so a phase's events finish before the next phase marker fires.
+ * The wall clock and the allocation counter are read at each marker. A
+ * loopback calibration phase measures what one packet costs the driver and
+ * the kernel. The reported net figures subtract that cost for every packet
+ * the driver created or consumed during a phase.
+ */
+class BenchmarkDriver : public cSimpleModule {
+  private:
+    enum Phase {
+        PHASE_COLLECTOR,      //!< Collector's fan-out inspection: statuses and collect acks.
+        PHASE_CALIBRATION,    //!< Driver-to-driver loopback.
+        PHASE_CAN_QUERY,      //!< Queries to every can, answered with a status.
+        PHASE_CAN_ACK,        //!< Collect acks to every can.
+        PHASE_CLOUD_STATUS,   //!< Status reports to the cloud.
+        PHASE_CLOUD_COLLECT,  //!< Collect requests to the cloud, answered with an ack.
+        PHASE_COUNT
+    };
+
+    struct PhaseResult {
+        const char *name;
+        long moduleEvents = 0;   //!< Packets handled by the module under test.
+        long driverPackets = 0;  //!< Packets created plus packets consumed by the driver.
+        double wallNs = 0;
+        long long allocations = 0;
+    };
+
+    int numCans = 0;
+    int repetitions = 0;
+    long calibrationPackets = 0;
+
+    PhaseResult results[PHASE_COUNT] = {
+        {"collector"}, {"calibration"}, {"canQuery"}, {"canCollectAck"}, {"cloudStatus"}, {"cloudCollect"}
+    };
+    int currentPhase = PHASE_COLLECTOR;
+    double phaseStartNs = 0;
+    AllocationSnapshot phaseStartHeap;
+    cMessage *phaseMarker = nullptr;
+    long nextRequestId = 0;
+
+    int fromHostCanBaseId = -1;
+    int fromHostCloudId = -1;
+
+    PhaseResult &current() { return results[currentPhase]; }
+
+    GarbagePacket *createPacket(const char *name, GarbageOpcode opcode, int canId)
+    {
+        auto *pkt = new GarbagePacket(name);
+        pkt->setOpcode(opcode);
+        pkt->setCanId(canId);
+        pkt->setTimestamp();
+        ++current().driverPackets;
+        return pkt;
+    }
+
+    /** Sends a packet that the module under test will handle. */
+    void sendToModule(GarbagePacket *pkt, const char *gateName, int index = -1)
+    {
+        ++current().moduleEvents;
+        send(pkt, gateName, index);
+    }
+
+    void startPhase()
+    {
+        phaseStartNs = wallClockSeconds() * 1e9;
+        phaseStartHeap = allocationSnapshot();
+    }
+
+    void endPhase()
+    {
+        const AllocationSnapshot heap = allocationSnapshot();
+        current().wallNs = wallClockSeconds() * 1e9 - phaseStartNs;
+        current().allocations = heap.allocations - phaseStartHeap.allocations;
+    }
+
+    /** Injects the whole stream of the phase that has just started. */
+    void injectStream()
+    {
+        switch (currentPhase) {
+            case PHASE_CALIBRATION:
+                for (long i = 0; i < calibrationPackets; ++i)
+                    send(createPacket("loopback", OP_NONE, 0), "loopOut");
+                break;
+            case PHASE_CAN_QUERY:
+                for (int rep = 0; rep < repetitions; ++rep) {
+                    for (int canId = 0; canId < numCans; ++canId) {
+                        auto *query = createPacket("Is the can full?", OP_QUERY, canId);
+                        query->setAttempt(rep + 1);
+                        sendToModule(query, "toCan", canId);
+                    }
+                }
+                break;
+            case PHASE_CAN_ACK:
+                for (int rep = 0; rep < repetitions; ++rep) {
+                    for (int canId = 0; canId < numCans; ++canId)
+                        sendToModule(createPacket("collect-OK", OP_COLLECT_ACK, canId), "toCanCloud", canId);
+                }
+                break;
+            case PHASE_CLOUD_STATUS:
+                for (int rep = 0; rep < repetitions; ++rep) {
+                    for (int canId = 0; canId < numCans; ++canId) {
+                        auto *status = createPacket("Yes", OP_STATUS_YES, canId);
+                        status->setIsFull(true);
+                        sendToModule(status, "toCloudCan", canId);
+                    }
+                }
+                break;
+            case PHASE_CLOUD_COLLECT:
+                for (int rep = 0; rep < repetitions; ++rep) {
+                    for (int canId = 0; canId < numCans; ++canId) {
+                        auto *collect = createPacket("Collect garbage", OP_COLLECT, canId);
+                        collect->setRequestId(nextRequestId++);
+                        sendToModule(collect, "toCloudHost");
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    /** Plays the cans and the cloud towards the collector. */
+    void answerCollector(GarbagePacket *pkt)
+    {
+        if (pkt->getOpcode() == OP_QUERY) {
+            auto *status = createPacket("Yes", OP_STATUS_YES, pkt->getCanId());
+            status->setIsFull(true);
+            status->setAttempt(pkt->getAttempt());
+            sendToModule(status, "toHostCan", pkt->getCanId());
+        }
+        else if (pkt->getOpcode() == OP_COLLECT) {
+            auto *ack = createPacket("collect-OK", OP_COLLECT_ACK, pkt->getCanId());
+            ack->setRequestId(pkt->getRequestId());
+            sendToModule(ack, "toHostCloud");
+        }
+    }
+
+    /** Per-packet driver cost measured by the calibration phase. */
+    double baselineNsPerPacket() const
+    {
+        const PhaseResult &calibration = results[PHASE_CALIBRATION];
+        return calibration.driverPackets > 0 ? calibration.wallNs / calibration.driverPackets : 0;
+    }
+
+    double baselineAllocationsPerPacket() const
+    {
+        const PhaseResult &calibration = results[PHASE_CALIBRATION];
+        return calibration.driverPackets > 0 ? double(calibration.allocations) / calibration.driverPackets : 0;
+    }
+
+    /** Heap taken by the modules between two probes, per module. */
+    double residentBytesPerModule(const char *probeName, const char *nextProbeName, int moduleCount) const
+    {
+        auto *probe = check_and_cast<HeapProbe *>(getParentModule()->getSubmodule(probeName, 0));
+        auto *next = check_and_cast<HeapProbe *>(getParentModule()->getSubmodule(nextProbeName, 0));
+        const long long built = next->atConstruction().liveBytes - probe->atConstruction().liveBytes;
+        const long long initialized = next->atInitialization().liveBytes - probe->atInitialization().liveBytes;
+        return moduleCount > 0 ? double(built + initialized) / moduleCount : 0;
+    }
+
+    void reportPhase(const PhaseResult &result, const char *module)
+    {
+        if (result.moduleEvents == 0)
+            return;
+
+        const double events = result.moduleEvents;
+        const double grossNs = result.wallNs / events;
+        const double netNs = (result.wallNs - result.driverPackets * baselineNsPerPacket()) / events;
+        const double grossAllocs = result.allocations / events;
+        const double netAllocs = (result.allocations - result.driverPackets * baselineAllocationsPerPacket()) / events;
+
+        std::printf("  %-14s %-17s %10ld %12.1f %12.1f %12.2f %12.2f\n",
+            result.name, module, result.moduleEvents, grossNs, netNs, grossAllocs, netAllocs);
+
+        const std::string prefix = result.name;
+        recordScalar((prefix + ".events").c_str(), result.moduleEvents);
+        recordScalar((prefix + ".nsPerEvent").c_str(), netNs);
+        recordScalar((prefix + ".grossNsPerEvent").c_str(), grossNs);
+        recordScalar((prefix + ".allocationsPerEvent").c_str(), netAllocs);
+    }
+
+  protected:
+    int numInitStages() const override
+    {
+        return 2;
+    }
+
+    void initialize(int stage) override
+    {
+        if (stage == 0) {
+            numCans = par("numCans");
+            repetitions = par("repetitions");
+            calibrationPackets = par("calibrationPackets").intValue();
+            fromHostCanBaseId = gateBaseId("fromHostCan");
+            fromHostCloudId = gate("fromHostCloud")->getId();
+            phaseMarker = new cMessage("phase");
+            return;
+        }
+
+        // Every module has been initialized; the collector's inspection is
+        // already scheduled for t=0 and forms the first phase.
+        scheduleAt(simTime() + 1, phaseMarker);
+        startPhase();
+    }
+
+    void handleMessage(cMessage *msg) override
+    {
+        if (msg == phaseMarker) {
+            endPhase();
+            if (++currentPhase == PHASE_COUNT)
+                return;
+            startPhase();
+            injectStream();
+            scheduleAt(simTime() + 1, phaseMarker);
+            return;
+        }
+
+        auto *pkt = check_and_cast<GarbagePacket *>(msg);
+        ++current().driverPackets;
+        if (pkt->getArrivalGate()->getBaseId() == fromHostCanBaseId || pkt->getArrivalGateId() == fromHostCloudId)
+            answerCollector(pkt);
+        delete pkt;
+    }
+
+    void finish() override
+    {
+        std::printf("HandlerBenchmark: %d cans, %d repetitions, driver baseline %.1f ns and %.2f allocations per packet\n",
+            numCans, repetitions, baselineNsPerPacket(), baselineAllocationsPerPacket());
+        std::printf("  %-14s %-17s %10s %12s %12s %12s %12s\n",
+            "phase", "module", "events", "ns/event", "net ns", "allocs/event", "net allocs");
+        reportPhase(results[PHASE_COLLECTOR], "GarbageCollector");
+        reportPhase(results[PHASE_CAN_QUERY], "GarbageCan");
+        reportPhase(results[PHASE_CAN_ACK], "GarbageCan");
+        reportPhase(results[PHASE_CLOUD_STATUS], "CloudServer");
+        reportPhase(results[PHASE_CLOUD_COLLECT], "CloudServer");
+
+        const double hostBytes = residentBytesPerModule("probeHost", "probeCans", 1);
+        const double canBytes = residentBytesPerModule("probeCans", "probeCloud", numCans);
+        const double cloudBytes = residentBytesPerModule("probeCloud", "probeEnd", 1);
+        std::printf("  resident bytes per module: GarbageCollector %.0f, GarbageCan %.0f, CloudServer %.0f\n",
+            hostBytes, canBytes, cloudBytes);
+        std::fflush(stdout);
+
+        recordScalar("collector.residentBytes", hostBytes);
+        recordScalar("can.residentBytes", canBytes);
+        recordScalar("cloud.residentBytes", cloudBytes);
+    }
+
+  public:
+    ~BenchmarkDriver() override
+    {
+        cancelAndDelete(phaseMarker);
+    }
+};
+Define_Module(BenchmarkDriver);
@@ -0,0 +1,378 @@
+#include <omnetpp.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include "CommandLabels.h"
+#include "ConsistentHashRing.h"
+#include "FleetSnapshot.h"
+#include "messages_m.h"
+
+using namespace omnetpp;
+using namespace garbage_collection;
+
+namespace {
+
+const simsignal_t routedSignal = cComponent::registerSignal("routed");
+const simsignal_t keysMovedSignal = cComponent::registerSignal("keysMoved");
+
+/** One entry of the shardSchedule parameter. */
+struct MembershipChange {
+    simtime_t time;
+    int shard = -1;
+    bool join = false;
+};
+
+} // namespace
+
+/**
+ * Routes cloud traffic to the shard owning the can; see CloudRouter.ned.
+ *
+ * The owner of every can is cached in a vector and only recomputed from the
+ * ring when the membership changes, so routing a packet is one lookup.
+ */
+class CloudRouter : public cSimpleModule {
+  private:
+    static constexpr int kCoordinatorShard = 0;  //!< Receives the packets without a can.
+
+    std::unique_ptr<ConsistentHashRing> ring;
+    std::vector<int> owners;                     //!< Owning shard per can id.
+    std::vector<long> routedPackets;             //!< Per shard.
+
+    std::vector<MembershipChange> schedule;      //!< Sorted by time.
+    size_t nextChange = 0;
+    cMessage *membershipEvent = nullptr;
+
+    long rebalances = 0;
+    long keysMoved = 0;
+    double keySpread = 0;                        //!< Most cans on one shard over the mean, after the last change.
+    long nextHandoffId = 0;
+
+    int inHostBaseId = -1;
+    int inCanBaseId = -1;
+    int inFogBaseId = -1;
+    int fromShardBaseId = -1;
+
+    int numShards() const { return gateSize("toShard"); }
+
+    int ownerOf(int canId) const
+    {
+        return (canId >= 0 && canId < int(owners.size())) ? owners[canId] : kCoordinatorShard;
+    }
+
+    void forward(GarbagePacket *pkt, int port, int portIndex, int shard)
+    {
+        auto *envelope = new ShardEnvelope(pkt->getName());
+        envelope->setOpcode(pkt->getOpcode());
+        envelope->setCanId(pkt->getCanId());
+        envelope->setPort(port);
+        envelope->setPortIndex(portIndex);
+        envelope->encapsulate(pkt);
+        ++routedPackets[shard];
+        emit(routedSignal, shard);
+        send(envelope, "toShard", shard);
+    }
+
+    /** Splits a fog summary into one summary per owning shard, keeping its request id. */
+    void forwardSummary(FogSummary *summary, int fog)
+    {
+        std::vector<FogSummary *> parts(numShards(), nullptr);
+        auto partFor = [&](int canId) {
+            FogSummary *&part = parts[ownerOf(canId)];
+            if (!part) {
+                part = new FogSummary(summary->getName());
+                part->setOpcode(OP_SUMMARY);
+                part->setCanId(-1);
+                part->setRequestId(summary->getRequestId());
+                part->setTimestamp(summary->getTimestamp());
+            }
+            return part;
+        };
+        for (size_t k = 0; k < summary->getStatusCanIdsArraySize(); ++k) {
+            FogSummary *part = partFor(summary->getStatusCanIds(k));
+            part->appendStatusCanIds(summary->getStatusCanIds(k));
+            part->appendStatusFull(summary->getStatusFull(k));
+        }
+        for (size_t k = 0; k < summary->getCollectCanIdsArraySize(); ++k)
+            partFor(summary->getCollectCanIds(k))->appendCollectCanIds(summary->getCollectCanIds(k));
+
+        for (int shard = 0; shard < numShards(); ++shard) {
+            if (parts[shard])
+                forward(parts[shard], PORT_FOG, fog, shard);
+        }
+        delete summary;
+    }
+
+    void routeInbound(GarbagePacket *pkt, int port, int portIndex)
+    {
+        if (port == PORT_FOG && pkt->getOpcode() == OP_SUMMARY)
+            forwardSummary(check_and_cast<FogSummary *>(pkt), portIndex);
+        else
+            forward(pkt, port, portIndex, ownerOf(pkt->getCanId()));
+    }
+
+    /** Sends a shard's reply out of the port it names. */
+    void routeOutbound(ShardEnvelope *envelope)
+    {
+        const int port = envelope->getPort();
+        const int index = envelope->getPortIndex();
+        auto *pkt = envelope->decapsulate();
+        delete envelope;
+
+        const char *gateName = port == PORT_HOST ? "outHost" : port == PORT_CAN ? "outCan" : port == PORT_FOG ? "outFog" : nullptr;
+        if (!gateName || index < 0 || index >= gateSize(gateName) || !gate(gateName, index)->isConnected()) {
+            EV_WARN << "Cloud router dropped '" << pkt->getName() << "' for unconnected port " << port << "[" << index << "]" << endl;
+            delete pkt;
+            return;
+        }
+        send(pkt, gateName, index);
+    }
+
+    /** Passes the states a shard released on to the cans' new owners. */
+    void relayHandoff(FogSummary *handoff)
+    {
+        std::vector<FogSummary *> parts(numShards(), nullptr);
+        for (size_t k = 0; k < handoff->getStatusCanIdsArraySize(); ++k) {
+            const int canId = handoff->getStatusCanIds(k);
+            FogSummary *&part = parts[ownerOf(canId)];
+            if (!part) {
+                part = new FogSummary("shard-handoff");
+                part->setOpcode(OP_SHARD_HANDOFF);
+                part->setCanId(-1);
+                part->setRequestId(handoff->getRequestId());
+            }
+            part->appendStatusCanIds(canId);
+            part->appendStatusFull(handoff->getStatusFull(k));
+        }
+        for (int shard = 0; shard < numShards(); ++shard) {
+            if (parts[shard])
+                send(parts[shard], "toShard", shard);
+        }
+        delete handoff;
+    }
+
+    /**
+     * Recomputes the owner of every can from the ring and asks the previous
+     * owner of each moved can to release it.
+     */
+    void rebalance()
+    {
+        std::vector<FogSummary *> releases(numShards(), nullptr);
+        long moved = 0;
+        for (int canId = 0; canId < int(owners.size()); ++canId) {
+            const int owner = ring->ownerOf(canId);
+            if (owner == owners[canId])
+                continue;
+            FogSummary *&release = releases[owners[canId]];
+            if (!release) {
+                release = new FogSummary("shard-handoff");
+                release->setOpcode(OP_SHARD_HANDOFF);
+                release->setCanId(-1);
+                release->setRequestId(nextHandoffId++);
+            }
+            release->appendCollectCanIds(canId);
+            owners[canId] = owner;
+            ++moved;
+        }
+        for (int shard = 0; shard < numShards(); ++shard) {
+            if (releases[shard])
+                send(releases[shard], "toShard", shard);
+        }
+
+        ++rebalances;
+        keysMoved += moved;
+        emit(keysMovedSignal, moved);
+        EV_INFO << "Cloud router rebalanced " << ring->shardCount() << " shards, moving " << moved << " of "
+                << owners.size() << " cans" << endl;
+        checkKeySpread();
+    }
+
+    /**
+     * Measures how evenly the cans are spread over the shards on the ring.
+     * A shard's share of the cans deviates from the mean by a relative
+     * sigma = sqrt(1/virtualNodes + 1/meanCans): its arc of the ring is the
+     * sum of virtualNodes random gaps, and the cans falling on it are a
+     * binomial sample. The busiest of n shards lies about sqrt(2 ln n) sigma
+     * above the mean, under 3 sigma for fewer than 90 shards, so a spread
+     * above 1 + 4 sigma does not happen on a healthy ring. It means keys and
+     * points are hashed unevenly, which would skew every load figure of the
+     * run.
+     */
+    void checkKeySpread()
+    {
+        std::vector<long> cansPerShard(numShards(), 0);
+        for (int owner : owners)
+            ++cansPerShard[owner];
+        const int shards = ring->shardCount();
+        if (owners.empty() || shards < 2)
+            return;
+
+        const double mean = double(owners.size()) / shards;
+        keySpread = *std::max_element(cansPerShard.begin(), cansPerShard.end()) / mean;
+        const double sigma = std::sqrt(1 / par("virtualNodes").doubleValue() + 1 / mean);
+        const double tolerance = 1 + 4 * sigma;
+        if (keySpread > tolerance)
+            EV_WARN << "Cloud router: the busiest of " << shards << " shards owns " << keySpread
+                    << " times the mean share of cans (expected below " << tolerance << ")" << endl;
+    }
+
+    /** Hands the statuses of a warm-start snapshot to the shards owning the cans. */
+    void seedShards(const FleetSnapshot &snapshot)
+    {
+        std::vector<FogSummary *> parts(numShards(), nullptr);
+        for (int canId = 0; canId < int(owners.size()); ++canId) {
+            const FleetSnapshot::CloudStatus status = snapshot.cloudStatus(canId);
+            if (status == FleetSnapshot::CLOUD_UNKNOWN)
+                continue;
+            FogSummary *&part = parts[owners[canId]];
+            if (!part) {
+                part = new FogSummary("shard-handoff");
+                part->setOpcode(OP_SHARD_HANDOFF);
+                part->setCanId(-1);
+                part->setRequestId(nextHandoffId++);
+            }
+            part->appendStatusCanIds(canId);
+            part->appendStatusFull(status == FleetSnapshot::CLOUD_FULL);
+        }
+        for (int shard = 0; shard < numShards(); ++shard) {
+            if (parts[shard])
+                send(parts[shard], "toShard", shard);
+        }
+    }
+
+    void applyMembershipChanges()
+    {
+        bool changed = false;
+        while (nextChange < schedule.size() && schedule[nextChange].time <= simTime()) {
+            const MembershipChange &change = schedule[nextChange++];
+            if (change.join) {
+                changed |= ring->addShard(change.shard);
+            }
+            else {
+                if (ring->contains(change.shard) && ring->shardCount() == 1)
+                    throw cRuntimeError("shardSchedule removes shard %d, the last one on the ring", change.shard);
+                changed |= ring->removeShard(change.shard);
+            }
+        }
+        if (changed)
+            rebalance();
+        if (nextChange < schedule.size())
+            scheduleAt(schedule[nextChange].time, membershipEvent);
+    }
+
+    void parseSchedule(const char *text)
+    {
+        cStringTokenizer entries(text, ";");
+        while (entries.hasMoreTokens()) {
+            const std::string entry = entries.nextToken();
+            std::vector<std::string> tokens = cStringTokenizer(entry.c_str()).asVector();
+            if (tokens.empty())
+                continue;
+            if (tokens.size() != 2 || tokens[1].size() < 2 || (tokens[1][0] != '+' && tokens[1][0] != '-'))
+                throw cRuntimeError("Malformed shardSchedule entry '%s' (expected '<time> +<shard>' or '<time> -<shard>')", entry.c_str());
+
+            MembershipChange change;
+            change.time = SimTime::parse(tokens[0].c_str());
+            change.join = tokens[1][0] == '+';
+            change.shard = std::stoi(tokens[1].substr(1));
+            if (change.time < SIMTIME_ZERO)
+                throw cRuntimeError("shardSchedule time must not be negative, got %s", tokens[0].c_str());
+            if (change.shard < 0 || change.shard >= numShards())
+                throw cRuntimeError("shardSchedule names shard %d, expected [0, %d)", change.shard, numShards());
+            schedule.push_back(change);
+        }
+        std::stable_sort(schedule.begin(), schedule.end(),
+                         [](const MembershipChange &a, const MembershipChange &b) { return a.time < b.time; });
+    }
+
+  protected:
+    void initialize() override
+    {
+        const int initialShards = par("initialShards");
+        if (initialShards < 1 || initialShards > numShards())
+            throw cRuntimeError("initialShards must be in [1, %d], got %d", numShards(), initialShards);
+
+        ring = std::make_unique<ConsistentHashRing>(par("virtualNodes").intValue());
+        for (int shard = 0; shard < initialShards; ++shard)
+            ring->addShard(shard);
+        owners.resize(gateSize("inCan"));
+        for (int canId = 0; canId < int(owners.size()); ++canId)
+            owners[canId] = ring->ownerOf(canId);
+        checkKeySpread();
+        routedPackets.assign(numShards(), 0);
+        const std::string warmStartFile = par("warmStartFile").stdstringValue();
+        if (!warmStartFile.empty())
+            seedShards(FleetSnapshot::open(warmStartFile, owners.size(), FleetSnapshot::Mode::Read));
+
+        parseSchedule(par("shardSchedule"));
+        membershipEvent = new cMessage("shard-membership");
+        if (!schedule.empty())
+            scheduleAt(schedule.front().time, membershipEvent);
+
+        inHostBaseId = gateBaseId("inHost");
+        inCanBaseId = gateBaseId("inCan");
+        inFogBaseId = gateBaseId("inFog");
+        fromShardBaseId = gateBaseId("fromShard");
+    }
+
+    void handleMessage(cMessage *msg) override
+    {
+        if (msg == membershipEvent) {
+            applyMembershipChanges();
+            return;
+        }
+
+        auto *pkt = check_and_cast<GarbagePacket *>(msg);
+        const cGate *arrivalGate = pkt->getArrivalGate();
+        const int baseId = arrivalGate->getBaseId();
+        if (baseId == fromShardBaseId) {
+            if (auto *envelope = dynamic_cast<ShardEnvelope *>(pkt)) {
+                routeOutbound(envelope);
+            }
+            else if (pkt->getOpcode() == OP_SHARD_HANDOFF) {
+                relayHandoff(check_and_cast<FogSummary *>(pkt));
+            }
+            else {
+                EV_WARN << "Cloud router received unknown command '" << commandLabel(pkt) << "' from a shard" << endl;
+                delete pkt;
+            }
+        }
+        else if (baseId == inHostBaseId) {
+            routeInbound(pkt, PORT_HOST, arrivalGate->getIndex());
+        }
+        else if (baseId == inCanBaseId) {
+            routeInbound(pkt, PORT_CAN, arrivalGate->getIndex());
+        }
+        else {
+            routeInbound(pkt, PORT_FOG, arrivalGate->getIndex());
+        }
+    }
+
+    void finish() override
+    {
+        recordScalar("rebalances", rebalances);
+        recordScalar("keysMoved", keysMoved);
+        if (keySpread > 0)
+            recordScalar("keySpread", keySpread);
+
+        // Busiest shard against the mean over the shards that got traffic.
+        long total = 0;
+        long busiest = 0;
+        int loaded = 0;
+        for (long packets : routedPackets) {
+            total += packets;
+            busiest = std::max(busiest, packets);
+            loaded += packets > 0;
+        }
+        if (loaded > 0)
+            recordScalar("loadImbalance", double(busiest) * loaded / total);
+    }
+
+  public:
+    ~CloudRouter() override
+    {
+        cancelAndDelete(membershipEvent);
+    }
+};
+Define_Module(CloudRouter);
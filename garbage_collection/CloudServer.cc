@@ -1,9 +1,17 @@
 #include <omnetpp.h>
+#include <algorithm>
 #include <cstring>
-#include <functional>
+#include <deque>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
+#include "CommandLabels.h"
+#include "FigureRegistry.h"
+#include "FleetSnapshot.h"
+#include "RoutePlanner.h"
+#include "WallClock.h"
 #include "messages_m.h"
 
 using namespace omnetpp;
@@ -11,49 +19,80 @@ using namespace garbage_collection;
 
 namespace {
 
-/**
- * Locates and returns the named text figure on the network canvas.
- * Throws a runtime error when the figure cannot be resolved.
- */
-cTextFigure *requireTextFigure(cModule *module, const char *name)
-{
-    if (!module)
-        throw cRuntimeError("Null module while searching for figure '%s'", name);
-
-    cCanvas *canvas = module->getParentModule()->getCanvas();
-    if (!canvas)
-        throw cRuntimeError("%s: canvas unavailable while searching for figure '%s'", module->getFullPath().c_str(), name);
-
-    std::function<cTextFigure *(cFigure *)> search = [&](cFigure *figure) -> cTextFigure * {
-        if (!figure)
-            return nullptr;
-        if (strcmp(figure->getName(), name) == 0)
-            return dynamic_cast<cTextFigure *>(figure);
-        for (int i = 0; i < figure->getNumFigures(); ++i) {
-            if (auto *child = search(figure->getFigure(i)))
-                return child;
-        }
-        return nullptr;
-    };
-
-    if (auto *result = search(canvas->getRootFigure()))
-        return result;
-
-    throw cRuntimeError("%s: unable to locate text figure '%s'", module->getFullPath().c_str(), name);
-}
+// One-way latencies of packets arriving from the collector, the cans and the fog aggregators.
+const simsignal_t hostToCloudLatencySignal = cComponent::registerSignal("hostToCloudLatency");
+const simsignal_t canToCloudLatencySignal = cComponent::registerSignal("canToCloudLatency");
+const simsignal_t fogToCloudLatencySignal = cComponent::registerSignal("fogToCloudLatency");
+
+// Event counts; values carry the can id.
+const simsignal_t statusReceivedSignal = cComponent::registerSignal("statusReceived");
+const simsignal_t collectReceivedSignal = cComponent::registerSignal("collectReceived");
+
+// Collection tour after each replan, and the wall-clock time the replan took.
+const simsignal_t tourLengthSignal = cComponent::registerSignal("tourLength");
+const simsignal_t tourStopsSignal = cComponent::registerSignal("tourStops");
+const simsignal_t replanTimeSignal = cComponent::registerSignal("replanTime");
+
+// Service queue; the overflow and backpressure counts carry the can id.
+const simsignal_t queueLengthSignal = cComponent::registerSignal("queueLength");
+const simsignal_t waitingTimeSignal = cComponent::registerSignal("waitingTime");
+const simsignal_t utilizationSignal = cComponent::registerSignal("utilization");
+const simsignal_t packetDroppedSignal = cComponent::registerSignal("packetDropped");
+const simsignal_t packetRejectedSignal = cComponent::registerSignal("packetRejected");
+const simsignal_t backpressureSentSignal = cComponent::registerSignal("backpressureSent");
+
+/** What the cloud knows about one collector for work stealing. */
+struct CollectorLoad {
+    int backlog = 0;            //!< Cans a peer may take over, as last reported.
+    bool idle = false;          //!< The collector's own round is resolved.
+    bool orderPending = false;  //!< Asked to hand cans over; grant outstanding.
+    bool awaitingGrant = false; //!< A peer was asked to hand cans to this collector.
+};
 
-/// Maps can identifiers to acknowledgement command labels.
-const char *collectAckCommandFor(int canId)
-{
-    return canId == 0 ? "8-OK" : "10-OK";
-}
+/** A packet admitted to the service queue, with the port it arrived by. */
+struct Job {
+    GarbagePacket *pkt = nullptr;
+    int port = PORT_NONE;
+    int portIndex = -1;
+    simtime_t arrival;
+};
 
-}
+} // namespace
 
 class CloudServer : public cSimpleModule {
   private:
         simtime_t ackDelay;                               //!< Delay applied to acknowledgements.
+        bool confirmCollectToCan = false;                 //!< Tell the can when the collector had it collected.
+        int cansPerFog = 0;                               //!< Cans served by each fog aggregator.
+        bool behindRouter = false;                        //!< A shard: all traffic comes and goes through outRouter.
         std::map<int, bool> latestStatuses;               //!< Last status message received per can.
+        std::vector<CollectorLoad> collectorLoads;        //!< Indexed like the inHost gates.
+        int stealThreshold = 2;                           //!< Smallest backlog worth splitting.
+        long stealOrders = 0;
+        long cansReassigned = 0;
+
+        std::unique_ptr<RoutePlanner> routePlanner;       //!< Tour over the full cans; null unless planRoutes.
+        double metresPerUnit = 1;                         //!< Canvas units to metres for the reported tour length.
+        int reoptimizeEvery = 0;                          //!< Tour changes between 2-opt passes; 0 never.
+        int changesSinceImprove = 0;
+        bool routeChanged = false;                        //!< The packet being handled changed the tour.
+        double routeSeconds = 0;                          //!< Wall-clock time spent on the current replan.
+        long replans = 0;
+        double totalReplanSeconds = 0;
+
+        std::deque<Job> waiting;                          //!< Admitted packets in arrival order.
+        std::vector<Job> inService;                       //!< Per worker; pkt is null while the worker is idle.
+        std::vector<cMessage *> serviceEvents;            //!< Per worker; the kind is the worker index.
+        int busyWorkers = 0;
+        int queueCapacity = 0;                            //!< Waiting packets beyond which overflowPolicy applies; 0 unbounded.
+        bool rejectOverflow = false;                      //!< Answer an overflow with OP_CLOUD_BUSY instead of dropping it.
+        int backpressureThreshold = 0;                    //!< Queue length from which senders are asked to slow down; 0 never.
+        std::map<std::pair<int, int>, simtime_t> backpressureQuietUntil;  //!< Per (port, index): no new warning before.
+        long packetsServed = 0;
+        double totalServiceSeconds = 0;
+
+        std::string snapshotFile;                         //!< Empty unless the status table is saved.
+        cMessage *snapshotEvent = nullptr;
 
         long sentFastCount = 0;
         long rcvdFastCount = 0;
@@ -61,7 +100,12 @@ class CloudServer : public cSimpleModule {
         long rcvdSlowCount = 0;
 
         cTextFigure *counterFigure = nullptr;             //!< Canvas figure showing cloud counters.
-        bool displayCounters = true;
+        mutable bool countersDirty = false;               //!< Counters changed since the last render.
+
+        int inHostBaseId = -1;                            //!< Cached ids for arrival classification.
+        int inCanBaseId = -1;
+        int inFogBaseId = -1;
+        int inRouterId = -1;
 
     /** Renders condensed counter information for the GUI and report. */
     std::string formatStatusText() const
@@ -74,183 +118,759 @@ class CloudServer : public cSimpleModule {
         return oss.str();
     }
 
-    /** Returns true when the provided module is expected to communicate with the cloud quickly. */
-    static bool moduleHasFastCloudTraffic(cModule *module)
-    {
-        if (!module)
-            return false;
-        bool report = module->hasPar("reportStatusToCloud") && module->par("reportStatusToCloud").boolValue();
-        bool sendCollect = module->hasPar("sendCollectToCloud") && module->par("sendCollectToCloud").boolValue();
-        return (report || sendCollect) && module->hasGate("outCloud") && module->gate("outCloud")->isConnected();
-    }
-
-    /** Determines whether the cloud counters figure should be visible. */
-    bool shouldDisplayCounters() const
-    {
-        cModule *parent = getParentModule();
-        auto *host = parent->getSubmodule("host", 0);
-        bool hostUsesCloud = host && host->hasGate("outCloud") && host->gate("outCloud")->isConnected()
-            && host->hasPar("hostSendsCollect") && host->par("hostSendsCollect").boolValue();
-        bool canUsesCloud = moduleHasFastCloudTraffic(parent->getSubmodule("can"));
-        bool anotherUsesCloud = moduleHasFastCloudTraffic(parent->getSubmodule("anotherCan"));
-        return hostUsesCloud || canUsesCloud || anotherUsesCloud;
-    }
-
-    /** Updates the cloud counter figure when visibility is enabled. */
-    void updateCounterFigure()
+    /**
+     * Re-renders the cloud counter figure; only called from refreshDisplay().
+     * The figure stays hidden until the first cloud message, which is how
+     * scenarios that never use the cloud are recognised without inspecting
+     * other modules (they may live in another partition).
+     */
+    void updateCounterFigure() const
     {
-        if (!counterFigure)
-            return;
-
-        counterFigure->setVisible(displayCounters);
-        if (!displayCounters)
+        if (!counterFigure || !countersDirty)
             return;
 
-        const std::string text = formatStatusText();
-        counterFigure->setText(text.c_str());
-
-        if (cModule *parent = getParentModule()) {
-            if (parent->hasPar("cloudCountersText"))
-                parent->par("cloudCountersText").setStringValue(text.c_str());
-        }
+        countersDirty = false;
+        counterFigure->setVisible(true);
+        counterFigure->setText(formatStatusText().c_str());
     }
 
     void recordFastSend()
     {
         ++sentFastCount;
-        updateCounterFigure();
+        countersDirty = true;
     }
 
     void recordFastReceive()
     {
         ++rcvdFastCount;
-        updateCounterFigure();
+        countersDirty = true;
     }
 
     void recordSlowSend()
     {
         ++sentSlowCount;
-        updateCounterFigure();
+        countersDirty = true;
     }
 
     void recordSlowReceive()
     {
         ++rcvdSlowCount;
-        updateCounterFigure();
+        countersDirty = true;
     }
 
     /**
-     * Attempts to deliver an acknowledgement to the originating module.
-     * Prefers mirroring the arrival path; falling back to any connected gate when necessary.
+     * Builds the route planner from the can positions. The cans must live in
+     * the cloud's partition, since their parameters are read directly.
      */
-    void sendAck(GarbagePacket *ack, cGate *arrivalGate)
+    void initRoutePlanner()
     {
-        const bool arrivedFromHost = arrivalGate && strcmp(arrivalGate->getBaseName(), "inHost") == 0;
-        const bool arrivedFromCan = arrivalGate && strcmp(arrivalGate->getBaseName(), "inCan") == 0;
+        const char *metricName = par("routeMetric");
+        RoutePlanner::Metric metric;
+        if (strcmp(metricName, "euclidean") == 0)
+            metric = RoutePlanner::Metric::Euclidean;
+        else if (strcmp(metricName, "manhattan") == 0)
+            metric = RoutePlanner::Metric::Manhattan;
+        else
+            throw cRuntimeError("Unknown routeMetric '%s' (expected 'euclidean' or 'manhattan')", metricName);
+
+        metresPerUnit = par("metresPerUnit");
+        reoptimizeEvery = par("reoptimizeEvery");
+        if (metresPerUnit <= 0)
+            throw cRuntimeError("metresPerUnit must be positive, got %g", metresPerUnit);
+        if (reoptimizeEvery < 0)
+            throw cRuntimeError("reoptimizeEvery must not be negative, got %d", reoptimizeEvery);
+
+        // The same layout the network gives the cans; reading their posX/posY
+        // instead would tie the cans to the cloud's partition.
+        const double gridX = par("canGridX");
+        const double gridY = par("canGridY");
+        const double pitch = par("canGridPitch");
+        const int columns = par("canGridColumns");
+        if (columns < 1)
+            throw cRuntimeError("canGridColumns must be at least 1, got %d", columns);
+        const int numCans = par("numCans");
+        std::vector<CanvasPoint> positions(numCans);
+        for (int canId = 0; canId < numCans; ++canId) {
+            if (canId == 0)
+                positions[canId] = {331, 108};
+            else if (canId == 1)
+                positions[canId] = {496, 541};
+            else
+                positions[canId] = {gridX + pitch * ((canId - 2) % columns), gridY + pitch * ((canId - 2) / columns)};
+        }
+        const CanvasPoint depot = {par("depotX").doubleValue(), par("depotY").doubleValue()};
+        routePlanner = std::make_unique<RoutePlanner>(std::move(positions), depot, metric);
+    }
 
-        auto trySendSlow = [&]() -> bool {
-            if (!gate("outHost")->isConnected())
-                return false;
+    /** Puts a can on the tour when it needs a visit and takes it off when it is empty. */
+    void updateRoute(int canId, bool needsVisit)
+    {
+        if (!routePlanner || canId < 0 || canId >= routePlanner->stopCount())
+            return;
+        const double start = wallClockSeconds();
+        if (needsVisit ? routePlanner->insert(canId) : routePlanner->remove(canId)) {
+            routeChanged = true;
+            ++changesSinceImprove;
+        }
+        routeSeconds += wallClockSeconds() - start;
+    }
+
+    /** Closes the replan of the packet just handled, improving the tour when due. */
+    void finishReplan()
+    {
+        if (!routeChanged)
+            return;
+        if (reoptimizeEvery > 0 && changesSinceImprove >= reoptimizeEvery) {
+            const double start = wallClockSeconds();
+            routePlanner->improve(0);
+            changesSinceImprove = 0;
+            routeSeconds += wallClockSeconds() - start;
+        }
+
+        ++replans;
+        totalReplanSeconds += routeSeconds;
+        emit(tourLengthSignal, routePlanner->length() * metresPerUnit);
+        emit(tourStopsSignal, long(routePlanner->size()));
+        emit(replanTimeSignal, routeSeconds);
+        routeChanged = false;
+        routeSeconds = 0;
+    }
+
+    void recordStatus(int canId, bool isFull)
+    {
+        latestStatuses[canId] = isFull;
+        updateRoute(canId, isFull);
+    }
+
+    static const char *outGateName(int port)
+    {
+        switch (port) {
+            case PORT_HOST: return "outHost";
+            case PORT_CAN: return "outCan";
+            case PORT_FOG: return "outFog";
+            default: throw cRuntimeError("Unknown cloud port %d", port);
+        }
+    }
+
+    /**
+     * Whether a packet can leave by the given port. A shard cannot see the
+     * router's gates, so it assumes the collector links and either the
+     * direct can links or the fog links, depending on cansPerFog.
+     */
+    bool portConnected(int port, int index)
+    {
+        if (!behindRouter)
+            return index >= 0 && index < gateSize(outGateName(port)) && gate(outGateName(port), index)->isConnected();
+        switch (port) {
+            case PORT_HOST: return index >= 0 && index < par("numHosts").intValue();
+            case PORT_CAN: return cansPerFog <= 0 && index >= 0 && index < par("numCans").intValue();
+            case PORT_FOG: return cansPerFog > 0 && index >= 0 && index < par("numFogs").intValue();
+            default: return false;
+        }
+    }
+
+    /** Sends after ackDelay on the given port, through the router when this is a shard. */
+    void sendOut(GarbagePacket *pkt, int port, int index)
+    {
+        if (port == PORT_HOST)
             recordSlowSend();
-            sendDelayed(ack, ackDelay, "outHost");
-            return true;
-        };
+        else
+            recordFastSend();
+
+        if (!behindRouter) {
+            sendDelayed(pkt, ackDelay, outGateName(port), index);
+            return;
+        }
+        auto *envelope = new ShardEnvelope(pkt->getName());
+        envelope->setOpcode(pkt->getOpcode());
+        envelope->setCanId(pkt->getCanId());
+        envelope->setPort(port);
+        envelope->setPortIndex(index);
+        envelope->encapsulate(pkt);
+        sendDelayed(envelope, ackDelay, "outRouter");
+    }
 
-        auto trySendFastToIndex = [&](int index) -> bool {
-            if (index < 0 || index >= gateSize("outCan") || !gate("outCan", index)->isConnected())
+    /**
+     * Attempts to deliver an acknowledgement to the originating module.
+     * Prefers mirroring the arrival path; falling back to any connected gate when necessary.
+     */
+    void sendAck(GarbagePacket *ack, int port, int portIndex)
+    {
+        auto trySend = [&](int toPort, int index) -> bool {
+            if (!portConnected(toPort, index))
                 return false;
-            recordFastSend();
-            sendDelayed(ack, ackDelay, "outCan", index);
+            sendOut(ack, toPort, index);
             return true;
         };
 
         bool delivered = false;
 
-        if (arrivedFromHost)
-            delivered = trySendSlow();
+        if (port == PORT_HOST)
+            delivered = trySend(PORT_HOST, portIndex);
 
-        if (!delivered && arrivedFromCan)
-            delivered = trySendFastToIndex(arrivalGate->getIndex());
+        if (!delivered && port == PORT_CAN)
+            delivered = trySend(PORT_CAN, portIndex);
 
         if (!delivered)
-            delivered = trySendSlow();
+            delivered = trySend(PORT_HOST, 0);
 
         if (!delivered) {
-            for (int i = 0; i < gateSize("outCan") && !delivered; ++i)
-                delivered = trySendFastToIndex(i);
+            const int numCans = par("numCans");
+            for (int i = 0; i < numCans && !delivered; ++i)
+                delivered = trySend(PORT_CAN, i);
+        }
+
+    }
+
+    /** Confirms a collector-requested collect to a can that sits behind a fog aggregator. */
+    bool confirmThroughFog(GarbagePacket *ack)
+    {
+        if (cansPerFog <= 0)
+            return false;
+        const int fog = ack->getCanId() / cansPerFog;
+        if (!portConnected(PORT_FOG, fog))
+            return false;
+
+        auto *summaryAck = new FogSummary("summary-ack");
+        summaryAck->setOpcode(OP_SUMMARY_ACK);
+        summaryAck->setCanId(-1);
+        summaryAck->setRequestId(ack->getRequestId());
+        summaryAck->setCollectCanIdsArraySize(1);
+        summaryAck->setCollectCanIds(0, ack->getCanId());
+        summaryAck->setTimestamp();
+        sendOut(summaryAck, PORT_FOG, fog);
+        return true;
+    }
+
+    /**
+     * Applies a fog aggregator's batch as if each entry had arrived on its
+     * own, and confirms all of its collects with a single summary ack.
+     */
+    void handleSummary(FogSummary *summary, int fog)
+    {
+        for (size_t k = 0; k < summary->getStatusCanIdsArraySize(); ++k) {
+            const int canId = summary->getStatusCanIds(k);
+            recordStatus(canId, summary->getStatusFull(k));
+            emit(statusReceivedSignal, canId);
+        }
+        const size_t collects = summary->getCollectCanIdsArraySize();
+        for (size_t k = 0; k < collects; ++k) {
+            emit(collectReceivedSignal, summary->getCollectCanIds(k));
+            updateRoute(summary->getCollectCanIds(k), true);
+        }
+        EV_INFO << "Cloud applied summary " << summary->getRequestId() << " from fog " << fog << ": "
+                << summary->getStatusCanIdsArraySize() << " statuses, " << collects << " collects" << endl;
+
+        if (collects == 0)
+            return;
+        auto *ack = new FogSummary("summary-ack");
+        ack->setOpcode(OP_SUMMARY_ACK);
+        ack->setCanId(-1);
+        ack->setRequestId(summary->getRequestId());
+        ack->setCollectCanIdsArraySize(collects);
+        for (size_t k = 0; k < collects; ++k)
+            ack->setCollectCanIds(k, summary->getCollectCanIds(k));
+        ack->setTimestamp();
+        sendOut(ack, PORT_FOG, fog);
+    }
+
+    void sendToCollector(WorkSteal *pkt, int host)
+    {
+        pkt->setTimestamp();
+        sendOut(pkt, PORT_HOST, host);
+    }
+
+    /**
+     * Pairs every idle collector with the busiest peer that is not already
+     * handing cans over, and orders that peer to give away half its backlog.
+     */
+    void matchIdleCollectors()
+    {
+        const int numHosts = collectorLoads.size();
+        for (int thief = 0; thief < numHosts; ++thief) {
+            CollectorLoad &idle = collectorLoads[thief];
+            if (!idle.idle || idle.awaitingGrant)
+                continue;
+
+            int victim = -1;
+            for (int host = 0; host < numHosts; ++host) {
+                const CollectorLoad &load = collectorLoads[host];
+                if (host != thief && !load.orderPending && load.backlog >= stealThreshold
+                    && (victim < 0 || load.backlog > collectorLoads[victim].backlog))
+                    victim = host;
+            }
+            if (victim < 0)
+                continue;
+
+            CollectorLoad &busy = collectorLoads[victim];
+            const int share = (busy.backlog + 1) / 2;
+            auto *order = new WorkSteal("steal-order");
+            order->setOpcode(OP_STEAL_ORDER);
+            order->setHostIndex(thief);
+            order->setBacklog(share);
+            sendToCollector(order, victim);
+            busy.orderPending = true;
+            busy.backlog -= share;
+            idle.awaitingGrant = true;
+            ++stealOrders;
+            EV_INFO << "Cloud asked collector " << victim << " to hand up to " << share
+                    << " cans to idle collector " << thief << endl;
+        }
+    }
+
+    void handleLoadReport(WorkSteal *report, int host)
+    {
+        CollectorLoad &load = collectorLoads[host];
+        if (!load.orderPending)
+            load.backlog = report->getBacklog();
+        load.idle = report->isIdle();
+        matchIdleCollectors();
+    }
+
+    /** Relays handed-over cans from the giving collector to the one that asked for work. */
+    void handleStealGrant(WorkSteal *grant, int giver)
+    {
+        CollectorLoad &giverLoad = collectorLoads[giver];
+        giverLoad.orderPending = false;
+        giverLoad.backlog = grant->getBacklog();
+        giverLoad.idle = grant->isIdle();
+
+        const int thief = grant->getHostIndex();
+        if (thief < 0 || thief >= int(collectorLoads.size()))
+            throw cRuntimeError("Steal grant for unknown collector %d", thief);
+        CollectorLoad &thiefLoad = collectorLoads[thief];
+        thiefLoad.awaitingGrant = false;
+
+        const size_t count = grant->getCanIdsArraySize();
+        if (count > 0) {
+            auto *relay = grant->dup();
+            relay->setHostIndex(giver);
+            sendToCollector(relay, thief);
+            thiefLoad.idle = false;
+            cansReassigned += count;
+            EV_INFO << "Cloud moved " << count << " cans from collector " << giver << " to collector " << thief << endl;
+        }
+        matchIdleCollectors();
+    }
+
+    /**
+     * Applies a rebalance of the router's hash ring. collectCanIds lists cans
+     * moving away from this shard: their states are returned to the router
+     * and forgotten here. statusCanIds/statusFull carry the states of cans
+     * moving to this shard.
+     */
+    void handleHandoff(FogSummary *handoff)
+    {
+        for (size_t k = 0; k < handoff->getStatusCanIdsArraySize(); ++k)
+            recordStatus(handoff->getStatusCanIds(k), handoff->getStatusFull(k));
+
+        const size_t released = handoff->getCollectCanIdsArraySize();
+        if (released == 0)
+            return;
+        auto *reply = new FogSummary("shard-handoff");
+        reply->setOpcode(OP_SHARD_HANDOFF);
+        reply->setCanId(-1);
+        reply->setRequestId(handoff->getRequestId());
+        for (size_t k = 0; k < released; ++k) {
+            const int canId = handoff->getCollectCanIds(k);
+            auto it = latestStatuses.find(canId);
+            if (it == latestStatuses.end())
+                continue;
+            reply->appendStatusCanIds(canId);
+            reply->appendStatusFull(it->second);
+            latestStatuses.erase(it);
+            updateRoute(canId, false);
         }
+        EV_INFO << "Cloud shard " << getIndex() << " handed " << reply->getStatusCanIdsArraySize() << " of "
+                << released << " released cans over" << endl;
+        send(reply, "outRouter");
+    }
 
+    /** Saves the status of every can this cloud (or shard) knows. */
+    void takeSnapshot()
+    {
+        const int numCans = par("numCans");
+        FleetSnapshot &snapshot = FleetSnapshot::open(snapshotFile, numCans, FleetSnapshot::Mode::Write);
+        snapshot.stamp(SIMTIME_DBL(simTime()));
+        for (const auto &entry : latestStatuses) {
+            if (entry.first >= 0 && entry.first < numCans)
+                snapshot.putCloudStatus(entry.first, entry.second ? FleetSnapshot::CLOUD_FULL : FleetSnapshot::CLOUD_EMPTY);
+        }
     }
 
-    bool isStatusCommand(const char *command) const
+    /** Starts from a snapshot's status table. Shards get theirs from the router instead. */
+    void warmStart(const FleetSnapshot &snapshot)
+    {
+        for (int canId = 0; canId < snapshot.numCans(); ++canId) {
+            const FleetSnapshot::CloudStatus status = snapshot.cloudStatus(canId);
+            if (status != FleetSnapshot::CLOUD_UNKNOWN)
+                recordStatus(canId, status == FleetSnapshot::CLOUD_FULL);
+        }
+        finishReplan();
+    }
+
+    /**
+     * Time a packet queued now would wait for a worker, from the mean service
+     * time so far. Senders turned away or slowed down get it as a retry hint.
+     */
+    simtime_t retryHint() const
     {
-        return strcmp(command, "2-NO") == 0 || strcmp(command, "3-YES") == 0
-            || strcmp(command, "5-NO") == 0 || strcmp(command, "6-YES") == 0;
+        const double meanService = packetsServed > 0 ? totalServiceSeconds / packetsServed : 0;
+        return std::max(ackDelay, SimTime(waiting.size() * meanService / serviceEvents.size()));
     }
 
-    bool isCollectCommand(const char *command) const
+    void emitLoad()
     {
-        return strcmp(command, "7-Collect garbage") == 0 || strcmp(command, "9-Collect garbage") == 0;
+        emit(queueLengthSignal, long(waiting.size()));
+        emit(utilizationSignal, double(busyWorkers) / serviceEvents.size());
+    }
+
+    /**
+     * Drops a packet that found the queue full, or returns it to the sender as
+     * OP_CLOUD_BUSY. Fog summaries are always returned: they are sent only
+     * once, and the aggregator has already marked their entries forwarded, so
+     * a dropped summary would lose those states and collects for good.
+     */
+    void overflow(GarbagePacket *pkt, int port, int portIndex)
+    {
+        const bool reject = rejectOverflow || pkt->getOpcode() == OP_SUMMARY;
+        if (!reject || port == PORT_NONE || !portConnected(port, portIndex)) {
+            emit(packetDroppedSignal, pkt->getCanId());
+            EV_INFO << "Cloud queue full, dropped '" << commandLabel(pkt) << "' of can " << pkt->getCanId() << endl;
+            delete pkt;
+            return;
+        }
+        emit(packetRejectedSignal, pkt->getCanId());
+        auto *busy = new GarbagePacket("cloud-busy");
+        busy->setOpcode(OP_CLOUD_BUSY);
+        busy->setCanId(pkt->getCanId());
+        busy->setRequestId(pkt->getRequestId());
+        busy->setTravelTime(SIMTIME_DBL(retryHint()));
+        busy->encapsulate(pkt);
+        busy->setTimestamp();
+        sendOut(busy, port, portIndex);
+    }
+
+    /** Asks a sender to slow down, at most once per retry hint. */
+    void sendBackpressure(int port, int portIndex, int canId)
+    {
+        if (port == PORT_NONE || !portConnected(port, portIndex))
+            return;
+        simtime_t &quietUntil = backpressureQuietUntil[{port, portIndex}];
+        if (simTime() < quietUntil)
+            return;
+        const simtime_t hint = retryHint();
+        quietUntil = simTime() + hint;
+
+        auto *warning = new GarbagePacket("backpressure");
+        warning->setOpcode(OP_BACKPRESSURE);
+        warning->setCanId(canId);
+        warning->setTravelTime(SIMTIME_DBL(hint));
+        warning->setTimestamp();
+        emit(backpressureSentSignal, canId);
+        sendOut(warning, port, portIndex);
+    }
+
+    /**
+     * Queues an arriving packet for the workers. Load reports and steal
+     * grants are small and losing one would strand cans, so they are queued
+     * even beyond queueCapacity.
+     */
+    void admit(GarbagePacket *pkt, int port, int portIndex)
+    {
+        const int opcode = pkt->getOpcode();
+        if (queueCapacity > 0 && int(waiting.size()) >= queueCapacity && opcode != OP_LOAD_REPORT && opcode != OP_STEAL_GRANT) {
+            overflow(pkt, port, portIndex);
+            return;
+        }
+        const int canId = pkt->getCanId();
+        waiting.push_back({pkt, port, portIndex, simTime()});
+        serveWaiting();  // may process and delete pkt
+        if (backpressureThreshold > 0 && int(waiting.size()) >= backpressureThreshold)
+            sendBackpressure(port, portIndex, canId);
+        emitLoad();
+    }
+
+    /** Hands waiting packets to idle workers; a zero service time handles the packet at once. */
+    void serveWaiting()
+    {
+        const int numWorkers = serviceEvents.size();
+        while (!waiting.empty() && busyWorkers < numWorkers) {
+            Job job = waiting.front();
+            waiting.pop_front();
+            emit(waitingTimeSignal, simTime() - job.arrival);
+
+            const simtime_t service = par("serviceTime");
+            if (service < SIMTIME_ZERO)
+                throw cRuntimeError("serviceTime must not be negative, got %s", service.str().c_str());
+            ++packetsServed;
+            totalServiceSeconds += SIMTIME_DBL(service);
+            if (service == SIMTIME_ZERO) {
+                process(job.pkt, job.port, job.portIndex);
+                continue;
+            }
+
+            int worker = 0;
+            while (inService[worker].pkt)
+                ++worker;
+            inService[worker] = job;
+            ++busyWorkers;
+            scheduleAfter(service, serviceEvents[worker]);
+        }
+    }
+
+    void finishService(int worker)
+    {
+        Job job = inService[worker];
+        inService[worker] = Job();
+        --busyWorkers;
+        process(job.pkt, job.port, job.portIndex);
+        serveWaiting();
+        emitLoad();
+    }
+
+    /** Handles a packet whose service is complete, as if it had just arrived by port. */
+    void process(GarbagePacket *pkt, int port, int portIndex)
+    {
+        switch (pkt->getOpcode()) {
+            case OP_STATUS_NO:
+            case OP_STATUS_YES:
+                recordStatus(pkt->getCanId(), pkt->isFull());
+                emit(statusReceivedSignal, pkt->getCanId());
+                EV_INFO << "Cloud recorded status from can " << pkt->getCanId()
+                        << " => " << (pkt->isFull() ? "full" : "empty") << endl;
+                break;
+            case OP_COLLECT: {
+                const int canId = pkt->getCanId();
+                emit(collectReceivedSignal, canId);
+                updateRoute(canId, true);
+                EV_INFO << "Cloud received collect request " << pkt->getRequestId() << " for can " << canId
+                        << " (note=" << (pkt->getNote() ? pkt->getNote() : "") << ")" << endl;
+
+                auto *ack = new GarbagePacket("collect-OK");
+                ack->setOpcode(OP_COLLECT_ACK);
+                ack->setCanId(canId);
+                ack->setIsFull(false);
+                ack->setTravelTime(SIMTIME_DBL(ackDelay));
+                ack->setNote("collect-confirmed");
+                ack->setRequestId(pkt->getRequestId());
+                ack->setTimestamp();
+
+                // Only the cloud can tell a can that the collector had it collected.
+                if (confirmCollectToCan && port == PORT_HOST && canId >= 0) {
+                    bool confirmed = false;
+                    if (portConnected(PORT_CAN, canId)) {
+                        sendOut(ack->dup(), PORT_CAN, canId);
+                        confirmed = true;
+                    }
+                    else {
+                        confirmed = confirmThroughFog(ack);
+                    }
+                    if (confirmed)
+                        recordStatus(canId, false);  // the confirmation empties the can
+                }
+                sendAck(ack, port, portIndex);
+                break;
+            }
+            case OP_NOTIFY: {
+                recordStatus(pkt->getCanId(), pkt->isFull());
+                emit(statusReceivedSignal, pkt->getCanId());
+                EV_INFO << "Cloud notified by can " << pkt->getCanId()
+                        << " => " << (pkt->isFull() ? "full" : "empty") << endl;
+
+                auto *ack = new GarbagePacket("notify-ack");
+                ack->setOpcode(OP_NOTIFY_ACK);
+                ack->setCanId(pkt->getCanId());
+                ack->setRequestId(pkt->getRequestId());
+                ack->setTimestamp();
+                sendAck(ack, port, portIndex);
+                break;
+            }
+            case OP_HEARTBEAT:
+                recordStatus(pkt->getCanId(), pkt->isFull());
+                break;
+            case OP_SUMMARY:
+                if (port == PORT_FOG)
+                    handleSummary(check_and_cast<FogSummary *>(pkt), portIndex);
+                else
+                    EV_WARN << "Cloud received a summary that did not come from a fog aggregator" << endl;
+                break;
+            case OP_LOAD_REPORT:
+            case OP_STEAL_GRANT: {
+                if (port != PORT_HOST) {
+                    EV_WARN << "Cloud received '" << commandLabel(pkt) << "' that did not come from a collector" << endl;
+                    break;
+                }
+                auto *steal = check_and_cast<WorkSteal *>(pkt);
+                if (pkt->getOpcode() == OP_LOAD_REPORT)
+                    handleLoadReport(steal, portIndex);
+                else
+                    handleStealGrant(steal, portIndex);
+                break;
+            }
+            case OP_CLOUD_ACK:
+                EV_INFO << "Cloud relayed acknowledgement received: "
+                        << (pkt->getNote() ? pkt->getNote() : "") << endl;
+                break;
+            default:
+                EV_WARN << "Cloud received unknown command '" << commandLabel(pkt) << "'" << endl;
+                break;
+        }
+
+        finishReplan();
+        delete pkt;
     }
 
   protected:
     void initialize() override
     {
         ackDelay = par("ackDelay");
-        counterFigure = requireTextFigure(this, "cloudCounters");
-        displayCounters = shouldDisplayCounters();
-        if (counterFigure) {
-            counterFigure->setVisible(displayCounters);
-            updateCounterFigure();
+        confirmCollectToCan = par("confirmCollectToCan");
+        cansPerFog = par("cansPerFog");
+        behindRouter = par("behindRouter");
+        stealThreshold = par("stealThreshold");
+        collectorLoads.resize(par("numHosts").intValue());
+
+        const int numWorkers = par("numWorkers");
+        queueCapacity = par("queueCapacity");
+        backpressureThreshold = par("backpressureThreshold");
+        if (numWorkers < 1)
+            throw cRuntimeError("numWorkers must be at least 1, got %d", numWorkers);
+        if (queueCapacity < 0)
+            throw cRuntimeError("queueCapacity must not be negative, got %d", queueCapacity);
+        if (backpressureThreshold < 0)
+            throw cRuntimeError("backpressureThreshold must not be negative, got %d", backpressureThreshold);
+        const char *policy = par("overflowPolicy");
+        if (strcmp(policy, "reject") == 0)
+            rejectOverflow = true;
+        else if (strcmp(policy, "drop") != 0)
+            throw cRuntimeError("Unknown overflowPolicy '%s' (expected 'drop' or 'reject')", policy);
+        inService.resize(numWorkers);
+        for (int worker = 0; worker < numWorkers; ++worker)
+            serviceEvents.push_back(new cMessage("service", worker));
+
+        inHostBaseId = gateBaseId("inHost");
+        inCanBaseId = gateBaseId("inCan");
+        inFogBaseId = gateBaseId("inFog");
+        inRouterId = gate("inRouter")->getId();
+        if (par("planRoutes"))
+            initRoutePlanner();
+        const std::string warmStartFile = par("warmStartFile").stdstringValue();
+        if (!warmStartFile.empty() && !behindRouter)
+            warmStart(FleetSnapshot::open(warmStartFile, par("numCans"), FleetSnapshot::Mode::Read));
+        snapshotFile = par("snapshotFile").stdstringValue();
+        const simtime_t snapshotAt = par("snapshotAt");
+        if (!snapshotFile.empty() && snapshotAt >= SIMTIME_ZERO) {
+            snapshotEvent = new cMessage("snapshot");
+            scheduleAt(snapshotAt, snapshotEvent);
         }
+        // Shards share the canvas; the counters show the first one.
+        counterFigure = getIndex() == 0 ? findTextFigure(this, "cloudCounters") : nullptr;
+        if (counterFigure)
+            counterFigure->setVisible(false);
     }
 
     void handleMessage(cMessage *msg) override
     {
-        auto *pkt = check_and_cast<GarbagePacket *>(msg);
-        const char *command = pkt->getCommand();
-        cGate *arrivalGate = pkt->getArrivalGate();
-
-        if (arrivalGate) {
-            const char *baseName = arrivalGate->getBaseName();
-            if (strcmp(baseName, "inHost") == 0)
-                recordSlowReceive();
-            else if (strcmp(baseName, "inCan") == 0)
-                recordFastReceive();
+        if (msg == snapshotEvent) {
+            takeSnapshot();
+            return;
+        }
+        if (msg->isSelfMessage()) {
+            finishService(msg->getKind());
+            return;
         }
 
-        if (isStatusCommand(command)) {
-            latestStatuses[pkt->getCanId()] = pkt->isFull();
-            EV_INFO << "Cloud recorded status from can " << pkt->getCanId()
-                    << " => " << (pkt->isFull() ? "full" : "empty") << endl;
+        // Packets from the router carry the port they entered the cloud by.
+        int port = PORT_NONE;
+        int portIndex = -1;
+        GarbagePacket *pkt = nullptr;
+        if (auto *envelope = dynamic_cast<ShardEnvelope *>(msg)) {
+            port = envelope->getPort();
+            portIndex = envelope->getPortIndex();
+            pkt = check_and_cast<GarbagePacket *>(envelope->decapsulate());
+            delete envelope;
         }
-        else if (isCollectCommand(command)) {
-            const int canId = pkt->getCanId();
-            EV_INFO << "Cloud received collect request for can " << canId
-                    << " (note=" << (pkt->getNote() ? pkt->getNote() : "") << ")" << endl;
-
-            auto *ack = new GarbagePacket("collect-OK");
-            ack->setCommand(collectAckCommandFor(canId));
-            ack->setCanId(canId);
-            ack->setIsFull(false);
-            ack->setTravelTime(SIMTIME_DBL(ackDelay));
-            ack->setNote("collect-confirmed");
-            sendAck(ack, arrivalGate);
+        else {
+            pkt = check_and_cast<GarbagePacket *>(msg);
+            const cGate *arrivalGate = pkt->getArrivalGate();
+            if (arrivalGate && arrivalGate->getId() == inRouterId) {
+                if (pkt->getOpcode() == OP_SHARD_HANDOFF)
+                    handleHandoff(check_and_cast<FogSummary *>(pkt));
+                else
+                    EV_WARN << "Cloud received unknown command '" << commandLabel(pkt) << "' from the router" << endl;
+                finishReplan();
+                delete pkt;
+                return;
+            }
+            if (arrivalGate) {
+                portIndex = arrivalGate->getIndex();
+                if (arrivalGate->getBaseId() == inHostBaseId)
+                    port = PORT_HOST;
+                else if (arrivalGate->getBaseId() == inCanBaseId)
+                    port = PORT_CAN;
+                else if (arrivalGate->getBaseId() == inFogBaseId)
+                    port = PORT_FOG;
+            }
         }
-        else if (strcmp(command, "cloud-ack") == 0) {
-            EV_INFO << "Cloud relayed acknowledgement received: "
-                    << (pkt->getNote() ? pkt->getNote() : "") << endl;
+
+        if (port == PORT_HOST) {
+            recordSlowReceive();
+            emit(hostToCloudLatencySignal, simTime() - pkt->getTimestamp(), pkt);
         }
-        else {
-            EV_WARN << "Cloud received unknown command '" << command << "'" << endl;
+        else if (port == PORT_CAN) {
+            recordFastReceive();
+            emit(canToCloudLatencySignal, simTime() - pkt->getTimestamp(), pkt);
+        }
+        else if (port == PORT_FOG) {
+            recordFastReceive();
+            emit(fogToCloudLatencySignal, simTime() - pkt->getTimestamp(), pkt);
         }
 
-        delete pkt;
+        admit(pkt, port, portIndex);
     }
 
     void refreshDisplay() const override
     {
-        const_cast<CloudServer *>(this)->updateCounterFigure();
+        updateCounterFigure();
+    }
+
+    void finish() override
+    {
+        if (!snapshotFile.empty() && !snapshotEvent)
+            takeSnapshot();  // no snapshotAt: the state at the end of the run
+
+        // Cloud ingress per can, comparable between poll and push mode.
+        const double canHours = par("numCans").intValue() * SIMTIME_DBL(simTime()) / 3600;
+        if (canHours > 0)
+            recordScalar("ingressPerCanHour", (rcvdFastCount + rcvdSlowCount) / canHours);
+        if (behindRouter) {
+            recordScalar("packetsHandled", rcvdFastCount + rcvdSlowCount);
+            recordScalar("cansKnown", long(latestStatuses.size()));
+        }
+        if (collectorLoads.size() > 1) {
+            recordScalar("stealOrders", stealOrders);
+            recordScalar("cansReassigned", cansReassigned);
+        }
+        if (routePlanner) {
+            recordScalar("finalTourLength", routePlanner->length() * metresPerUnit, "m");
+            recordScalar("finalTourStops", long(routePlanner->size()));
+            recordScalar("replans", replans);
+            if (replans > 0)
+                recordScalar("meanReplanTime", totalReplanSeconds / replans, "s");
+        }
+    }
+
+  public:
+    ~CloudServer() override
+    {
+        cancelAndDelete(snapshotEvent);
+        for (cMessage *event : serviceEvents)
+            cancelAndDelete(event);
+        for (Job &job : inService)
+            delete job.pkt;
+        for (Job &job : waiting)
+            delete job.pkt;
     }
 };
 Define_Module(CloudServer);
@@ -0,0 +1,68 @@
+#ifndef GARBAGE_COLLECTION_COMMANDLABELS_H
+#define GARBAGE_COLLECTION_COMMANDLABELS_H
+
+#include "messages_m.h"
+
+namespace garbage_collection {
+
+/**
+ * Returns the numbered assignment label ("1-Is the can full?", "6-YES", ...)
+ * for an opcode. Can 0 uses the first numbering and every other can the
+ * second, mirroring the original can/anotherCan message tables. Only meant
+ * for logging, counter reports and the GUI; dispatch uses the opcode.
+ */
+inline const char *commandLabel(GarbageOpcode opcode, int canId)
+{
+    const bool first = (canId == 0);
+    switch (opcode) {
+        case OP_QUERY: return first ? "1-Is the can full?" : "4-Is the can full?";
+        case OP_STATUS_NO: return first ? "2-NO" : "5-NO";
+        case OP_STATUS_YES: return first ? "3-YES" : "6-YES";
+        case OP_COLLECT: return first ? "7-Collect garbage" : "9-Collect garbage";
+        case OP_COLLECT_ACK: return first ? "8-OK" : "10-OK";
+        case OP_CLOUD_ACK: return "cloud-ack";
+        case OP_NOTIFY: return "notify";
+        case OP_NOTIFY_ACK: return "notify-ack";
+        case OP_HEARTBEAT: return "heartbeat";
+        case OP_SUMMARY: return "summary";
+        case OP_SUMMARY_ACK: return "summary-ack";
+        case OP_LOAD_REPORT: return "load-report";
+        case OP_STEAL_ORDER: return "steal-order";
+        case OP_STEAL_GRANT: return "steal-grant";
+        case OP_SHARD_HANDOFF: return "shard-handoff";
+        case OP_CLOUD_BUSY: return "cloud-busy";
+        case OP_BACKPRESSURE: return "backpressure";
+        default: return "<unknown>";
+    }
+}
+
+/** Returns true when the opcode's label differs between can 0 and the other cans. */
+inline bool hasPerCanLabel(GarbageOpcode opcode)
+{
+    switch (opcode) {
+        case OP_QUERY:
+        case OP_STATUS_NO:
+        case OP_STATUS_YES:
+        case OP_COLLECT:
+        case OP_COLLECT_ACK:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/** Convenience overload labelling a packet by its opcode and can id. */
+inline const char *commandLabel(const GarbagePacket *pkt)
+{
+    return commandLabel(pkt->getOpcode(), pkt->getCanId());
+}
+
+/** Returns the status opcode matching a fill state. */
+inline GarbageOpcode statusOpcode(bool isFull)
+{
+    return isFull ? OP_STATUS_YES : OP_STATUS_NO;
+}
+
+} // namespace garbage_collection
+
+#endif
@@ -0,0 +1,68 @@
+#include "ConsistentHashRing.h"
+
+#include <omnetpp.h>
+#include <algorithm>
+
+using namespace omnetpp;
+
+namespace garbage_collection {
+
+namespace {
+
+// Ring points are hashed in their own domain. Hashing them over the same
+// values as the keys would put shard 0's point r exactly on key r, so cans
+// 0..virtualNodes-1 would all land on shard 0.
+const uint64_t kPointDomain = 0x5bd1e9955bd1e995ULL;
+
+} // namespace
+
+ConsistentHashRing::ConsistentHashRing(int virtualNodes) : virtualNodes(virtualNodes)
+{
+    if (virtualNodes < 1)
+        throw cRuntimeError("virtualNodes must be at least 1, got %d", virtualNodes);
+}
+
+uint64_t ConsistentHashRing::hash(uint64_t value)
+{
+    // splitmix64 finalizer: consecutive can ids and shard points spread evenly.
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+bool ConsistentHashRing::contains(int shard) const
+{
+    return std::any_of(points.begin(), points.end(), [shard](const auto &point) { return point.second == shard; });
+}
+
+bool ConsistentHashRing::addShard(int shard)
+{
+    if (shard < 0)
+        throw cRuntimeError("Shard index must not be negative, got %d", shard);
+    if (contains(shard))
+        return false;
+    for (int replica = 0; replica < virtualNodes; ++replica)
+        points.emplace_back(hash(hash(kPointDomain ^ uint64_t(shard)) ^ uint64_t(replica)), shard);
+    std::sort(points.begin(), points.end());
+    return true;
+}
+
+bool ConsistentHashRing::removeShard(int shard)
+{
+    const auto end = std::remove_if(points.begin(), points.end(), [shard](const auto &point) { return point.second == shard; });
+    if (end == points.end())
+        return false;
+    points.erase(end, points.end());
+    return true;
+}
+
+int ConsistentHashRing::ownerOf(uint64_t key) const
+{
+    if (points.empty())
+        throw cRuntimeError("Consistent hash ring has no shards");
+    const auto it = std::lower_bound(points.begin(), points.end(), std::make_pair(hash(key), 0));
+    return it == points.end() ? points.front().second : it->second;
+}
+
+} // namespace garbage_collection
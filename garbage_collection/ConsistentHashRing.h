@@ -0,0 +1,43 @@
+#ifndef GARBAGE_COLLECTION_CONSISTENTHASHRING_H
+#define GARBAGE_COLLECTION_CONSISTENTHASHRING_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace garbage_collection {
+
+/**
+ * Maps keys to shards by consistent hashing. Every shard owns
+ * virtualNodes points on a 64-bit ring and a key belongs to the shard of
+ * the first point at or after the key's hash, so adding or removing a shard
+ * only moves the keys between that shard's points and their predecessors,
+ * about 1/n of them.
+ */
+class ConsistentHashRing {
+  public:
+    explicit ConsistentHashRing(int virtualNodes);
+
+    /** Adds a shard's points; false if the shard is already on the ring. */
+    bool addShard(int shard);
+
+    /** Removes a shard's points; false if the shard was not on the ring. */
+    bool removeShard(int shard);
+
+    /** Shard owning key; the ring must not be empty. */
+    int ownerOf(uint64_t key) const;
+
+    bool contains(int shard) const;
+    bool empty() const { return points.empty(); }
+    int shardCount() const { return int(points.size()) / virtualNodes; }
+
+  private:
+    static uint64_t hash(uint64_t value);
+
+    int virtualNodes;
+    std::vector<std::pair<uint64_t, int>> points;  //!< (hash, shard), sorted by hash.
+};
+
+} // namespace garbage_collection
+
+#endif
@@ -0,0 +1,109 @@
+#include "FigureRegistry.h"
+
+#include <vector>
+
+using namespace omnetpp;
+
+namespace garbage_collection {
+
+Register_GlobalConfigOption(CFGID_GARBAGE_FIGURES, "garbage-figures", CFG_BOOL, "true",
+    "Set to false to run the garbage collection model without its canvas figures, even under a GUI.");
+
+#ifndef GARBAGE_HEADLESS
+bool figuresEnabled()
+{
+    return FigureRegistry::getInstance().enabled();
+}
+#endif
+
+FigureRegistry &FigureRegistry::getInstance()
+{
+    static FigureRegistry instance;
+    return instance;
+}
+
+#ifndef GARBAGE_HEADLESS
+bool FigureRegistry::enabled()
+{
+    // Modules ask on every counter update; the config lookup is done once.
+    if (figuresSetting < 0) {
+        listen();
+        cEnvir *envir = getEnvir();
+        figuresSetting = envir->isGUI() && envir->getConfig()->getAsBool(CFGID_GARBAGE_FIGURES);
+    }
+    return figuresSetting;
+}
+#endif
+
+cFigure *FigureRegistry::find(cModule *module, const char *name)
+{
+    if (!module)
+        throw cRuntimeError("Null module while searching for figure '%s'", name);
+
+    if (!figuresEnabled())
+        return nullptr;
+
+    cModule *owner = module->getParentModule() ? module->getParentModule() : module;
+    cCanvas *canvas = owner->getCanvas();
+    if (!canvas)
+        throw cRuntimeError("%s: canvas unavailable while searching for figure '%s'",
+            module->getFullPath().c_str(), name);
+
+    if (canvas != indexedCanvas)
+        buildIndex(canvas);
+
+    auto it = figuresByName.find(name);
+    return it != figuresByName.end() ? it->second : nullptr;
+}
+
+cTextFigure *FigureRegistry::findText(cModule *module, const char *name)
+{
+    cFigure *figure = find(module, name);
+    if (!figure) {
+        if (figuresEnabled())
+            EV_WARN << module->getFullPath() << ": no text figure '" << name << "' on the canvas, not displaying it" << endl;
+        return nullptr;
+    }
+    return check_and_cast<cTextFigure *>(figure);
+}
+
+void FigureRegistry::lifecycleEvent(SimulationLifecycleEventType eventType, cObject *details)
+{
+    if (eventType == LF_PRE_NETWORK_DELETE) {
+        indexedCanvas = nullptr;
+        figuresByName.clear();
+        figuresSetting = -1;
+    }
+}
+
+void FigureRegistry::listen()
+{
+    if (!listening) {
+        getEnvir()->addLifecycleListener(this);
+        listening = true;
+    }
+}
+
+/**
+ * Indexes every figure below the canvas root in pre-order, so the first
+ * figure of a given name wins just like the old recursive search.
+ */
+void FigureRegistry::buildIndex(cCanvas *canvas)
+{
+    listen();
+    figuresByName.clear();
+    indexedCanvas = canvas;
+
+    std::vector<cFigure *> pending {canvas->getRootFigure()};
+    while (!pending.empty()) {
+        cFigure *figure = pending.back();
+        pending.pop_back();
+        if (!figure)
+            continue;
+        figuresByName.emplace(figure->getName(), figure);
+        for (int i = figure->getNumFigures() - 1; i >= 0; --i)
+            pending.push_back(figure->getFigure(i));
+    }
+}
+
+} // namespace garbage_collection
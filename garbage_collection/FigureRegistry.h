@@ -0,0 +1,73 @@
+#ifndef GARBAGE_COLLECTION_FIGUREREGISTRY_H
+#define GARBAGE_COLLECTION_FIGUREREGISTRY_H
+
+#include <omnetpp.h>
+#include <string>
+#include <unordered_map>
+
+namespace garbage_collection {
+
+/**
+ * True when the modules should use canvas figures at all: only with a GUI,
+ * and only unless the run sets garbage-figures = false. Headless builds
+ * (make headless, which defines GARBAGE_HEADLESS) compile the figure code
+ * out, so this is a constant false there and every lookup folds away.
+ * Otherwise the setting is read once per network and cached by the
+ * FigureRegistry.
+ */
+#ifdef GARBAGE_HEADLESS
+inline bool figuresEnabled() { return false; }
+#else
+bool figuresEnabled();
+#endif
+
+/**
+ * Name index over the figures of the network canvas, shared by all modules.
+ *
+ * The first lookup walks the canvas figure tree once; every later lookup is a
+ * hash probe. With figures disabled nothing is indexed and lookups return
+ * nullptr, so Cmdenv runs never touch the figure tree. The index is dropped
+ * when the network is deleted.
+ */
+class FigureRegistry : public omnetpp::cISimulationLifecycleListener {
+  public:
+    static FigureRegistry &getInstance();
+
+    /** Returns the named figure on the module's parent canvas, or nullptr. */
+    omnetpp::cFigure *find(omnetpp::cModule *module, const char *name);
+
+    /**
+     * Returns the named text figure, or nullptr when figures are disabled or
+     * the network does not declare it. Throws only when a figure of that name
+     * exists but is not a text figure.
+     */
+    omnetpp::cTextFigure *findText(omnetpp::cModule *module, const char *name);
+
+#ifndef GARBAGE_HEADLESS
+    /** The figures setting of the current network, read on first use. */
+    bool enabled();
+#endif
+
+  protected:
+    void lifecycleEvent(omnetpp::SimulationLifecycleEventType eventType, omnetpp::cObject *details) override;
+
+  private:
+    omnetpp::cCanvas *indexedCanvas = nullptr;
+    std::unordered_map<std::string, omnetpp::cFigure *> figuresByName;
+    int figuresSetting = -1;  //!< Cached figuresEnabled(): -1 until read, then 0 or 1.
+    bool listening = false;
+
+    FigureRegistry() = default;
+    void listen();
+    void buildIndex(omnetpp::cCanvas *canvas);
+};
+
+/** Shorthand used by the modules for their optional counter figures. */
+inline omnetpp::cTextFigure *findTextFigure(omnetpp::cModule *module, const char *name)
+{
+    return figuresEnabled() ? FigureRegistry::getInstance().findText(module, name) : nullptr;
+}
+
+} // namespace garbage_collection
+
+#endif
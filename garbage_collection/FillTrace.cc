@@ -0,0 +1,138 @@
+#include "FillTrace.h"
+
+#include <omnetpp.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <map>
+#include <memory>
+
+using namespace omnetpp;
+
+namespace garbage_collection {
+
+namespace {
+
+const char kMagic[8] = {'G', 'C', 'T', 'R', 'A', 'C', 'E', '1'};
+const uint32_t kVersion = 1;
+
+static_assert(sizeof(FillTrace::Header) == 16, "trace header layout changed");
+static_assert(sizeof(FillTrace::Event) == 24, "trace event layout changed");
+
+/** Keeps the mapped traces of the current network; drops them when it is deleted. */
+class TraceRegistry : public cISimulationLifecycleListener {
+  public:
+    static TraceRegistry &getInstance()
+    {
+        static TraceRegistry instance;
+        return instance;
+    }
+
+    const FillTrace *find(const std::string &path)
+    {
+        auto it = traces.find(path);
+        return it != traces.end() ? it->second.get() : nullptr;
+    }
+
+    const FillTrace &add(const std::string &path, const FillTrace *trace)
+    {
+        if (!listening) {
+            getEnvir()->addLifecycleListener(this);
+            listening = true;
+        }
+        traces[path].reset(trace);
+        return *trace;
+    }
+
+  protected:
+    void lifecycleEvent(SimulationLifecycleEventType eventType, cObject *details) override
+    {
+        if (eventType == LF_PRE_NETWORK_DELETE)
+            traces.clear();
+    }
+
+  private:
+    std::map<std::string, std::unique_ptr<const FillTrace>> traces;
+    bool listening = false;
+};
+
+} // namespace
+
+const FillTrace &FillTrace::open(const std::string &path)
+{
+    TraceRegistry &registry = TraceRegistry::getInstance();
+    if (const FillTrace *trace = registry.find(path))
+        return *trace;
+    return registry.add(path, new FillTrace(path));
+}
+
+FillTrace::FillTrace(const std::string &path) : path(path)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw cRuntimeError("Cannot open fill trace '%s': %s", path.c_str(), strerror(errno));
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        const int error = errno;
+        ::close(fd);
+        throw cRuntimeError("Cannot stat fill trace '%s': %s", path.c_str(), strerror(error));
+    }
+    length = status.st_size;
+    if (length < sizeof(Header) + sizeof(uint64_t)) {
+        ::close(fd);
+        throw cRuntimeError("'%s' is too short for a fill trace", path.c_str());
+    }
+
+    base = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    const int error = errno;
+    ::close(fd);  // the mapping keeps the file open
+    if (base == MAP_FAILED) {
+        base = nullptr;
+        throw cRuntimeError("Cannot map fill trace '%s': %s", path.c_str(), strerror(error));
+    }
+    // Cans read far apart from each other; read-ahead would only fill memory.
+    madvise(base, length, MADV_RANDOM);
+
+    const auto *header = static_cast<const Header *>(base);
+    if (memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 || header->version != kVersion) {
+        munmap(base, length);
+        throw cRuntimeError("'%s' is not a version %u fill trace", path.c_str(), kVersion);
+    }
+    // The can count is untrusted: it must leave room for its own index before
+    // anything is read through it.
+    const uint32_t claimedCans = header->numCans;
+    if (claimedCans > (length - sizeof(Header)) / sizeof(uint64_t) - 1 || claimedCans > uint32_t(INT_MAX)) {
+        munmap(base, length);
+        throw cRuntimeError("Fill trace '%s' claims %u cans, more than its size allows", path.c_str(), claimedCans);
+    }
+    cans = claimedCans;
+    const size_t eventsOffset = sizeof(Header) + (size_t(cans) + 1) * sizeof(uint64_t);
+    index = reinterpret_cast<const uint64_t *>(static_cast<const char *>(base) + sizeof(Header));
+    events = reinterpret_cast<const Event *>(static_cast<const char *>(base) + eventsOffset);
+    if (length < eventsOffset || index[0] != 0 || (length - eventsOffset) % sizeof(Event) != 0
+        || index[cans] != (length - eventsOffset) / sizeof(Event)) {
+        munmap(base, length);
+        throw cRuntimeError("Fill trace '%s' is truncated or its index does not match its size", path.c_str());
+    }
+}
+
+FillTrace::~FillTrace()
+{
+    munmap(base, length);
+}
+
+uint64_t FillTrace::firstEvent(int canId) const
+{
+    if (canId < 0 || canId > cans)
+        throw cRuntimeError("Can %d is not in the %d-can fill trace '%s'", canId, cans, path.c_str());
+    const uint64_t position = index[canId];
+    if (position > index[cans] || (canId > 0 && position < index[canId - 1]))
+        throw cRuntimeError("Fill trace '%s' has a corrupt index entry for can %d", path.c_str(), canId);
+    return position;
+}
+
+} // namespace garbage_collection
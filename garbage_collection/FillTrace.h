@@ -0,0 +1,70 @@
+#ifndef GARBAGE_COLLECTION_FILLTRACE_H
+#define GARBAGE_COLLECTION_FILLTRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace garbage_collection {
+
+/**
+ * Recorded fill events of a fleet, replayed by cans with fillModel "trace".
+ *
+ * The file holds a Header, an index of numCans + 1 uint64_t entries (the
+ * position of each can's first event; the last entry is the event count),
+ * then the Events grouped by can and in time order within a can, all in host
+ * byte order. It is memory-mapped read-only and every can walks its own
+ * events with a cursor, so only the pages around the cursors are resident
+ * and traces larger than RAM replay in bounded memory.
+ */
+class FillTrace {
+  public:
+    enum EventKind : uint32_t {
+        EVENT_FILL_RATE = 1,  //!< From time on, the can fills at value litres per hour.
+        EVENT_DEPOSIT = 2,    //!< value litres are thrown in at time.
+    };
+
+    struct Header {
+        char magic[8];        //!< "GCTRACE1".
+        uint32_t version;
+        uint32_t numCans;
+    };
+
+    struct Event {
+        double time;          //!< Simulation time in seconds.
+        double value;
+        uint32_t kind;        //!< An EventKind.
+        uint32_t reserved;
+    };
+
+    /**
+     * The trace at path, mapped once per process and shared by every can
+     * replaying it; the mapping is released when the network is deleted.
+     * Throws when the file is not a well-formed trace.
+     */
+    static const FillTrace &open(const std::string &path);
+
+    ~FillTrace();
+    FillTrace(const FillTrace &) = delete;
+    FillTrace &operator=(const FillTrace &) = delete;
+
+    int numCans() const { return cans; }
+
+    /** Position of the can's first event; its events end at firstEvent(canId + 1). */
+    uint64_t firstEvent(int canId) const;
+    const Event &event(uint64_t position) const { return events[position]; }
+
+  private:
+    explicit FillTrace(const std::string &path);
+
+    std::string path;
+    int cans = 0;
+    const uint64_t *index = nullptr;
+    const Event *events = nullptr;
+    void *base = nullptr;
+    size_t length = 0;
+};
+
+} // namespace garbage_collection
+
+#endif
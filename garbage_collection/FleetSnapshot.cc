@@ -0,0 +1,223 @@
+#include "FleetSnapshot.h"
+
+#include <omnetpp.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <memory>
+
+using namespace omnetpp;
+
+namespace garbage_collection {
+
+namespace {
+
+const char kMagic[8] = {'G', 'C', 'S', 'N', 'A', 'P', '0', '1'};
+const uint32_t kVersion = 1;
+
+static_assert(sizeof(FleetSnapshot::Header) == 24, "snapshot header layout changed");
+static_assert(sizeof(FleetSnapshot::CanRecord) == 32, "snapshot can record layout changed");
+static_assert(sizeof(FleetSnapshot::CollectorRecord) == 40, "snapshot collector record layout changed");
+
+/** Keeps the mapped snapshots of the current network; drops them when it is deleted. */
+class SnapshotRegistry : public cISimulationLifecycleListener {
+  public:
+    static SnapshotRegistry &getInstance()
+    {
+        static SnapshotRegistry instance;
+        return instance;
+    }
+
+    FleetSnapshot *find(const std::string &path)
+    {
+        auto it = snapshots.find(path);
+        return it != snapshots.end() ? it->second.get() : nullptr;
+    }
+
+    FleetSnapshot &add(const std::string &path, FleetSnapshot *snapshot)
+    {
+        if (!listening) {
+            getEnvir()->addLifecycleListener(this);
+            listening = true;
+        }
+        snapshots[path].reset(snapshot);
+        return *snapshot;
+    }
+
+  protected:
+    void lifecycleEvent(SimulationLifecycleEventType eventType, cObject *details) override
+    {
+        if (eventType == LF_PRE_NETWORK_DELETE)
+            snapshots.clear();
+    }
+
+  private:
+    std::map<std::string, std::unique_ptr<FleetSnapshot>> snapshots;
+    bool listening = false;
+};
+
+} // namespace
+
+FleetSnapshot &FleetSnapshot::open(const std::string &path, int numCans, Mode mode)
+{
+    SnapshotRegistry &registry = SnapshotRegistry::getInstance();
+    if (FleetSnapshot *snapshot = registry.find(path)) {
+        if (snapshot->mode != mode)
+            throw cRuntimeError("Snapshot '%s' is both written and warm-started from in one run", path.c_str());
+        if (snapshot->cans != numCans)
+            throw cRuntimeError("Snapshot '%s' is shared by fleets of %d and %d cans", path.c_str(), snapshot->cans, numCans);
+        return *snapshot;
+    }
+    return registry.add(path, new FleetSnapshot(path, numCans, mode));
+}
+
+size_t FleetSnapshot::canOffset(int numCans)
+{
+    return (sizeof(Header) + numCans + 7) & ~size_t(7);
+}
+
+size_t FleetSnapshot::collectorOffset(int numCans)
+{
+    return canOffset(numCans) + numCans * sizeof(CanRecord);
+}
+
+size_t FleetSnapshot::fileSize(int numCans)
+{
+    return collectorOffset(numCans) + numCans * sizeof(CollectorRecord);
+}
+
+FleetSnapshot::FleetSnapshot(const std::string &path, int numCans, Mode mode)
+    : path(path), mode(mode), cans(numCans), length(fileSize(numCans))
+{
+    if (numCans < 0)
+        throw cRuntimeError("Snapshot fleet size must not be negative, got %d", numCans);
+
+    const bool writable = mode == Mode::Write;
+    // A snapshot is written from scratch: bytes left by an earlier run would
+    // read back as state for entries nobody wrote this time.
+    const int fd = ::open(path.c_str(), writable ? O_RDWR | O_CREAT | O_TRUNC : O_RDONLY, 0644);
+    if (fd < 0)
+        throw cRuntimeError("Cannot open snapshot '%s': %s", path.c_str(), strerror(errno));
+
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        const int error = errno;
+        ::close(fd);
+        throw cRuntimeError("Cannot stat snapshot '%s': %s", path.c_str(), strerror(error));
+    }
+    if (writable && ftruncate(fd, length) != 0) {
+        const int error = errno;
+        ::close(fd);
+        throw cRuntimeError("Cannot size snapshot '%s': %s", path.c_str(), strerror(error));
+    }
+    if (!writable && size_t(status.st_size) != length) {
+        ::close(fd);
+        throw cRuntimeError("Snapshot '%s' has %ld bytes, expected %zu for %d cans", path.c_str(),
+            long(status.st_size), length, numCans);
+    }
+
+    void *mapped = mmap(nullptr, length, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+        writable ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+    const int error = errno;
+    ::close(fd);  // the mapping keeps the file open
+    if (mapped == MAP_FAILED)
+        throw cRuntimeError("Cannot map snapshot '%s': %s", path.c_str(), strerror(error));
+    base = static_cast<unsigned char *>(mapped);
+
+    if (writable) {
+        auto *head = reinterpret_cast<Header *>(base);
+        memcpy(head->magic, kMagic, sizeof(kMagic));
+        head->version = kVersion;
+        head->numCans = numCans;
+        return;
+    }
+
+    // The destructor does not run when the constructor throws, so a rejected
+    // file is unmapped here.
+    if (memcmp(header()->magic, kMagic, sizeof(kMagic)) != 0 || header()->version != kVersion) {
+        munmap(base, length);
+        throw cRuntimeError("'%s' is not a version %u fleet snapshot", path.c_str(), kVersion);
+    }
+    const uint32_t heldCans = header()->numCans;
+    if (heldCans != uint32_t(numCans)) {
+        munmap(base, length);
+        throw cRuntimeError("Snapshot '%s' holds %u cans, expected %d", path.c_str(), heldCans, numCans);
+    }
+    // Every can reads its records during initialize(); fault the file in at once.
+    madvise(base, length, MADV_WILLNEED);
+}
+
+FleetSnapshot::~FleetSnapshot()
+{
+    if (mode == Mode::Write)
+        msync(base, length, MS_SYNC);
+    munmap(base, length);
+}
+
+void FleetSnapshot::checkCan(int canId) const
+{
+    if (canId < 0 || canId >= cans)
+        throw cRuntimeError("Can %d is outside the %d-can snapshot '%s'", canId, cans, path.c_str());
+}
+
+void FleetSnapshot::checkWritable() const
+{
+    if (mode != Mode::Write)
+        throw cRuntimeError("Snapshot '%s' was opened for warm-starting and cannot be written", path.c_str());
+}
+
+FleetSnapshot::CloudStatus FleetSnapshot::cloudStatus(int canId) const
+{
+    checkCan(canId);
+    const uint8_t status = base[sizeof(Header) + canId];
+    return status <= CLOUD_FULL ? CloudStatus(status) : CLOUD_UNKNOWN;
+}
+
+const FleetSnapshot::CanRecord *FleetSnapshot::findCan(int canId) const
+{
+    checkCan(canId);
+    const auto *record = reinterpret_cast<const CanRecord *>(base + canOffset(cans)) + canId;
+    return record->valid ? record : nullptr;
+}
+
+const FleetSnapshot::CollectorRecord *FleetSnapshot::findCollector(int canId) const
+{
+    checkCan(canId);
+    const auto *record = reinterpret_cast<const CollectorRecord *>(base + collectorOffset(cans)) + canId;
+    return record->valid ? record : nullptr;
+}
+
+void FleetSnapshot::stamp(double takenAt)
+{
+    checkWritable();
+    reinterpret_cast<Header *>(base)->takenAt = takenAt;
+}
+
+void FleetSnapshot::putCloudStatus(int canId, CloudStatus status)
+{
+    checkWritable();
+    checkCan(canId);
+    base[sizeof(Header) + canId] = status;
+}
+
+void FleetSnapshot::putCan(int canId, CanRecord record)
+{
+    checkWritable();
+    checkCan(canId);
+    record.valid = 1;
+    memcpy(base + canOffset(cans) + canId * sizeof(CanRecord), &record, sizeof(record));
+}
+
+void FleetSnapshot::putCollector(int canId, CollectorRecord record)
+{
+    checkWritable();
+    checkCan(canId);
+    record.valid = 1;
+    memcpy(base + collectorOffset(cans) + canId * sizeof(CollectorRecord), &record, sizeof(record));
+}
+
+} // namespace garbage_collection
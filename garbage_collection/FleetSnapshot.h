@@ -0,0 +1,106 @@
+#ifndef GARBAGE_COLLECTION_FLEETSNAPSHOT_H
+#define GARBAGE_COLLECTION_FLEETSNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace garbage_collection {
+
+/**
+ * Fleet state at one simulation time, kept in a flat binary file that is
+ * memory-mapped both for taking the snapshot and for warm-starting from it.
+ *
+ * The file holds a Header, one byte of cloud status per can, then a
+ * CanRecord and a CollectorRecord per can, all in host byte order. Every
+ * module writes only its own entries, so cloud shards, collectors and cans
+ * take the snapshot independently. The file is recreated the first time a
+ * process opens it for writing, so entries nobody wrote stay zero and read
+ * as unknown; partitions in different processes therefore need a file each.
+ */
+class FleetSnapshot {
+  public:
+    enum CloudStatus : uint8_t {
+        CLOUD_UNKNOWN = 0,
+        CLOUD_EMPTY = 1,
+        CLOUD_FULL = 2,
+    };
+
+    struct Header {
+        char magic[8];           //!< "GCSNAP01".
+        uint32_t version;
+        uint32_t numCans;
+        double takenAt;          //!< Simulation time of the snapshot, in seconds.
+    };
+
+    struct CanRecord {
+        double fillLevel;        //!< Litres.
+        double fillRate;         //!< Litres per second.
+        int64_t nextNotifySeq;
+        uint8_t valid;
+        uint8_t hasGarbage;
+        uint8_t overflowing;
+        uint8_t reserved[5];
+    };
+
+    struct CollectorRecord {
+        double srtt;             //!< Seconds; negative before the first sample.
+        double rttvar;           //!< Seconds.
+        double rto;              //!< Seconds.
+        int64_t lastNotifySeq;
+        uint8_t valid;
+        int8_t state;            //!< -1 unknown, 0 empty, 1 full.
+        uint8_t reserved[6];
+    };
+
+    enum class Mode { Read, Write };
+
+    /**
+     * The snapshot at path, mapped once per process and shared by every
+     * module asking for it; the mapping is released when the network is
+     * deleted. Write mode creates the file, or empties and resizes it, for
+     * numCans cans.
+     * Read mode throws unless the file is a snapshot of numCans cans.
+     */
+    static FleetSnapshot &open(const std::string &path, int numCans, Mode mode);
+
+    ~FleetSnapshot();
+    FleetSnapshot(const FleetSnapshot &) = delete;
+    FleetSnapshot &operator=(const FleetSnapshot &) = delete;
+
+    int numCans() const { return header()->numCans; }
+    double takenAt() const { return header()->takenAt; }
+
+    CloudStatus cloudStatus(int canId) const;
+
+    /** The can's record, or nullptr when the snapshot has none. */
+    const CanRecord *findCan(int canId) const;
+    const CollectorRecord *findCollector(int canId) const;
+
+    /** Write mode: sets the snapshot time in the header. */
+    void stamp(double takenAt);
+    void putCloudStatus(int canId, CloudStatus status);
+    void putCan(int canId, CanRecord record);
+    void putCollector(int canId, CollectorRecord record);
+
+  private:
+    FleetSnapshot(const std::string &path, int numCans, Mode mode);
+
+    static size_t fileSize(int numCans);
+    static size_t canOffset(int numCans);
+    static size_t collectorOffset(int numCans);
+
+    const Header *header() const { return reinterpret_cast<const Header *>(base); }
+    void checkCan(int canId) const;
+    void checkWritable() const;
+
+    std::string path;
+    Mode mode;
+    int cans = 0;
+    unsigned char *base = nullptr;
+    size_t length = 0;
+};
+
+} // namespace garbage_collection
+
+#endif
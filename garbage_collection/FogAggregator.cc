@@ -0,0 +1,332 @@
+#include <omnetpp.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "CommandLabels.h"
+#include "messages_m.h"
+
+using namespace omnetpp;
+using namespace garbage_collection;
+
+namespace {
+
+const simsignal_t summarySentSignal = cComponent::registerSignal("summarySent");
+const simsignal_t messageAbsorbedSignal = cComponent::registerSignal("messageAbsorbed");
+
+} // namespace
+
+/**
+ * Fog node between a neighbourhood of cans and the cloud; see FogAggregator.ned.
+ *
+ * Per-can state is kept in arrays indexed by the local gate index. Entries
+ * waiting for the next summary are additionally listed in arrival order, so
+ * a flush only visits the cans that reported since the previous one.
+ */
+class FogAggregator : public cSimpleModule {
+  private:
+    static constexpr int8_t kUnknownState = -1;
+
+    enum CollectState : uint8_t {
+        COLLECT_NONE,
+        COLLECT_PENDING,   //!< Waiting for the next summary.
+        COLLECT_AWAITING,  //!< Forwarded, cloud confirmation outstanding.
+    };
+
+    int firstCanId = 0;
+    simtime_t flushInterval;
+    int maxBatch = 0;
+
+    std::vector<int8_t> pendingStates;      //!< Latest unforwarded fill state, or kUnknownState.
+    std::vector<int8_t> forwardedStates;    //!< Fill state last forwarded to the cloud, or kUnknownState.
+    std::vector<uint8_t> collectStates;     //!< CollectState per can.
+    std::vector<long> collectRequestIds;    //!< Request id of the can's collect, echoed in the relayed ack.
+    std::vector<int> pendingStatusCans;     //!< Local indexes with a pending state.
+    std::vector<int> pendingCollectCans;    //!< Local indexes with a pending collect.
+
+    cMessage *flushEvent = nullptr;
+    simtime_t pausedUntil;                  //!< The cloud asked for no summary before this.
+    long nextBatchId = 0;
+
+    long canMessagesIn = 0;
+    long canMessagesOut = 0;
+    long summariesSent = 0;
+    long summaryAcksReceived = 0;
+
+    int inCanBaseId = -1;
+
+    int pendingEntries() const
+    {
+        return int(pendingStatusCans.size() + pendingCollectCans.size());
+    }
+
+    void absorbed(int index)
+    {
+        emit(messageAbsorbedSignal, firstCanId + index);
+    }
+
+    /** Flushes at once when the batch is full, otherwise arms the flush timer. */
+    void entryAdded()
+    {
+        if (maxBatch > 0 && pendingEntries() >= maxBatch && simTime() >= pausedUntil)
+            flush();
+        else if (!flushEvent->isScheduled())
+            scheduleAt(std::max(simTime() + flushInterval, pausedUntil), flushEvent);
+    }
+
+    void sendToCan(GarbagePacket *pkt, int index)
+    {
+        pkt->setTimestamp();
+        ++canMessagesOut;
+        send(pkt, "outCan", index);
+    }
+
+    /** Keeps only the latest fill state per can until the next flush. */
+    void mergeStatus(int index, bool isFull)
+    {
+        ++canMessagesIn;
+        if (pendingStates[index] != kUnknownState) {
+            absorbed(index);  // supersedes the state already waiting
+            pendingStates[index] = isFull;
+            return;
+        }
+        pendingStates[index] = isFull;
+        pendingStatusCans.push_back(index);
+        entryAdded();
+    }
+
+    void mergeCollect(int index, long requestId)
+    {
+        ++canMessagesIn;
+        if (collectStates[index] != COLLECT_NONE) {
+            absorbed(index);  // already pending or awaiting the cloud
+            return;
+        }
+        collectStates[index] = COLLECT_PENDING;
+        collectRequestIds[index] = requestId;
+        pendingCollectCans.push_back(index);
+        entryAdded();
+    }
+
+    void ackNotification(GarbagePacket *notify, int index)
+    {
+        auto *ack = new GarbagePacket("notify-ack");
+        ack->setOpcode(OP_NOTIFY_ACK);
+        ack->setCanId(notify->getCanId());
+        ack->setRequestId(notify->getRequestId());
+        sendToCan(ack, index);
+    }
+
+    /**
+     * Sends everything pending as one summary. States equal to the one the
+     * cloud already has are dropped here rather than on arrival, since a
+     * can may flip back and forth between two flushes.
+     */
+    void flush()
+    {
+        cancelEvent(flushEvent);
+
+        auto *summary = new FogSummary("fog-summary");
+        summary->setOpcode(OP_SUMMARY);
+        summary->setCanId(-1);
+        summary->setRequestId(nextBatchId++);
+
+        summary->setStatusCanIdsArraySize(pendingStatusCans.size());
+        summary->setStatusFullArraySize(pendingStatusCans.size());
+        size_t statuses = 0;
+        for (int index : pendingStatusCans) {
+            const int8_t state = pendingStates[index];
+            pendingStates[index] = kUnknownState;
+            if (state == forwardedStates[index]) {
+                absorbed(index);
+                continue;
+            }
+            forwardedStates[index] = state;
+            summary->setStatusCanIds(statuses, firstCanId + index);
+            summary->setStatusFull(statuses, state != 0);
+            ++statuses;
+        }
+        summary->setStatusCanIdsArraySize(statuses);
+        summary->setStatusFullArraySize(statuses);
+
+        summary->setCollectCanIdsArraySize(pendingCollectCans.size());
+        for (size_t k = 0; k < pendingCollectCans.size(); ++k) {
+            const int index = pendingCollectCans[k];
+            collectStates[index] = COLLECT_AWAITING;
+            summary->setCollectCanIds(k, firstCanId + index);
+        }
+
+        pendingStatusCans.clear();
+        pendingCollectCans.clear();
+
+        const long entries = statuses + summary->getCollectCanIdsArraySize();
+        if (entries == 0) {
+            delete summary;
+            return;
+        }
+
+        summary->setTimestamp();
+        emit(summarySentSignal, entries);
+        ++summariesSent;
+        EV_INFO << "Fog aggregator flushed summary " << summary->getRequestId() << " with " << statuses
+                << " statuses and " << summary->getCollectCanIdsArraySize() << " collects" << endl;
+        send(summary, "outCloud");
+    }
+
+    /** Relays every collect the cloud confirmed to its can. */
+    void handleSummaryAck(FogSummary *ack)
+    {
+        ++summaryAcksReceived;
+        for (size_t k = 0; k < ack->getCollectCanIdsArraySize(); ++k) {
+            const int canId = ack->getCollectCanIds(k);
+            const int index = canId - firstCanId;
+            if (index < 0 || index >= gateSize("outCan")) {
+                EV_WARN << "Fog aggregator got a collect confirmation for foreign can " << canId << endl;
+                continue;
+            }
+
+            // Confirmations the cloud sends on its own (collects requested by
+            // the collector) carry the summary ack's request id instead.
+            const bool requested = collectStates[index] == COLLECT_AWAITING;
+            auto *collectAck = new GarbagePacket("collect-OK");
+            collectAck->setOpcode(OP_COLLECT_ACK);
+            collectAck->setCanId(canId);
+            collectAck->setIsFull(false);
+            collectAck->setNote("collect-confirmed");
+            collectAck->setRequestId(requested ? collectRequestIds[index] : ack->getRequestId());
+            if (requested)
+                collectStates[index] = COLLECT_NONE;
+            sendToCan(collectAck, index);
+        }
+    }
+
+    /** Holds the next summary back for the cloud's retry hint. */
+    void pauseSummaries(simtime_t hint)
+    {
+        pausedUntil = std::max(pausedUntil, simTime() + hint);
+        if (flushEvent->isScheduled() && flushEvent->getArrivalTime() < pausedUntil) {
+            cancelEvent(flushEvent);
+            scheduleAt(pausedUntil, flushEvent);
+        }
+    }
+
+    /**
+     * The cloud's queue was full and the summary came back. Its entries are
+     * pending again, except for states a newer report has replaced, and go
+     * out with the first summary after the retry hint.
+     */
+    void handleRejectedSummary(const FogSummary *summary, simtime_t hint)
+    {
+        const int numCans = gateSize("outCan");
+        for (size_t k = 0; k < summary->getStatusCanIdsArraySize(); ++k) {
+            const int index = summary->getStatusCanIds(k) - firstCanId;
+            if (index < 0 || index >= numCans)
+                continue;
+            forwardedStates[index] = kUnknownState;
+            if (pendingStates[index] == kUnknownState) {
+                pendingStates[index] = summary->getStatusFull(k);
+                pendingStatusCans.push_back(index);
+            }
+        }
+        for (size_t k = 0; k < summary->getCollectCanIdsArraySize(); ++k) {
+            const int index = summary->getCollectCanIds(k) - firstCanId;
+            if (index < 0 || index >= numCans || collectStates[index] != COLLECT_AWAITING)
+                continue;
+            collectStates[index] = COLLECT_PENDING;
+            pendingCollectCans.push_back(index);
+        }
+
+        pauseSummaries(hint);
+        if (pendingEntries() > 0 && !flushEvent->isScheduled())
+            scheduleAt(pausedUntil, flushEvent);
+        EV_INFO << "Cloud turned summary " << summary->getRequestId() << " away, retrying in " << hint << "s" << endl;
+    }
+
+    void handleCanPacket(GarbagePacket *pkt, int index)
+    {
+        switch (pkt->getOpcode()) {
+            case OP_STATUS_NO:
+            case OP_STATUS_YES:
+            case OP_HEARTBEAT:
+                mergeStatus(index, pkt->isFull());
+                break;
+            case OP_NOTIFY:
+                mergeStatus(index, pkt->isFull());
+                ackNotification(pkt, index);
+                break;
+            case OP_COLLECT:
+                mergeCollect(index, pkt->getRequestId());
+                break;
+            default:
+                ++canMessagesIn;
+                EV_WARN << "Fog aggregator received unknown command '" << commandLabel(pkt) << "' from can "
+                        << pkt->getCanId() << endl;
+                break;
+        }
+    }
+
+  protected:
+    void initialize() override
+    {
+        firstCanId = par("firstCanId");
+        flushInterval = par("flushInterval");
+        maxBatch = par("maxBatch");
+        if (flushInterval < SIMTIME_ZERO)
+            throw cRuntimeError("flushInterval must not be negative, got %s", flushInterval.str().c_str());
+        if (maxBatch < 0)
+            throw cRuntimeError("maxBatch must not be negative, got %d", maxBatch);
+
+        const int numCans = gateSize("inCan");
+        pendingStates.assign(numCans, kUnknownState);
+        forwardedStates.assign(numCans, kUnknownState);
+        collectStates.assign(numCans, COLLECT_NONE);
+        collectRequestIds.assign(numCans, 0);
+        pendingStatusCans.reserve(numCans);
+        pendingCollectCans.reserve(numCans);
+
+        inCanBaseId = gateBaseId("inCan");
+        flushEvent = new cMessage("flush");
+    }
+
+    void handleMessage(cMessage *msg) override
+    {
+        if (msg == flushEvent) {
+            flush();
+            return;
+        }
+
+        auto *pkt = check_and_cast<GarbagePacket *>(msg);
+        if (pkt->getArrivalGate()->getBaseId() == inCanBaseId) {
+            handleCanPacket(pkt, pkt->getArrivalGate()->getIndex());
+        }
+        else if (pkt->getOpcode() == OP_SUMMARY_ACK) {
+            handleSummaryAck(check_and_cast<FogSummary *>(pkt));
+        }
+        else if (pkt->getOpcode() == OP_CLOUD_BUSY) {
+            if (auto *summary = dynamic_cast<const FogSummary *>(pkt->getEncapsulatedPacket()))
+                handleRejectedSummary(summary, pkt->getTravelTime());
+        }
+        else if (pkt->getOpcode() == OP_BACKPRESSURE) {
+            pauseSummaries(pkt->getTravelTime());
+        }
+        else {
+            EV_WARN << "Fog aggregator received unknown command '" << commandLabel(pkt) << "' from the cloud" << endl;
+        }
+        delete pkt;
+    }
+
+    void finish() override
+    {
+        recordScalar("canMessagesIn", canMessagesIn);
+        recordScalar("canMessagesOut", canMessagesOut);
+        recordScalar("cloudMessages", summariesSent + summaryAcksReceived);
+        if (summariesSent > 0)
+            recordScalar("reductionFactor", double(canMessagesIn) / summariesSent);
+    }
+
+  public:
+    ~FogAggregator() override
+    {
+        cancelAndDelete(flushEvent);
+    }
+};
+Define_Module(FogAggregator);
@@ -1,9 +1,15 @@
 #include <omnetpp.h>
-#include <cstring>
-#include <functional>
-#include <map>
+#include <algorithm>
+#include <cmath>
+#include <memory>
 #include <sstream>
 #include <string>
+#include "CommandLabels.h"
+#include "FigureRegistry.h"
+#include "FillTrace.h"
+#include "FleetSnapshot.h"
+#include "LossModel.h"
+#include "MessageCounters.h"
 #include "messages_m.h"
 
 using namespace omnetpp;
@@ -11,75 +17,54 @@ using namespace garbage_collection;
 
 namespace {
 
-/**
- * Finds and returns a named text figure attached to the parent canvas.
- * Throws if the figure is missing so that the simulation fails fast.
- */
-cTextFigure *requireTextFigure(cModule *module, const char *name)
-{
-    if (!module)
-        throw cRuntimeError("Null module while searching for figure '%s'", name);
-
-    cCanvas *canvas = module->getParentModule()->getCanvas();
-    if (!canvas)
-        throw cRuntimeError("%s: canvas unavailable while searching for figure '%s'",
-            module->getFullPath().c_str(), name);
-
-    std::function<cTextFigure *(cFigure *)> search = [&](cFigure *figure) -> cTextFigure * {
-        if (!figure)
-            return nullptr;
-        if (strcmp(figure->getName(), name) == 0)
-            return dynamic_cast<cTextFigure *>(figure);
-        for (int i = 0; i < figure->getNumFigures(); ++i) {
-            if (auto *child = search(figure->getFigure(i)))
-                return child;
-        }
-        return nullptr;
-    };
-
-    if (auto *result = search(canvas->getRootFigure()))
-        return result;
+// One-way latencies of packets arriving from the collector and the cloud.
+const simsignal_t hostToCanLatencySignal = cComponent::registerSignal("hostToCanLatency");
+const simsignal_t cloudToCanLatencySignal = cComponent::registerSignal("cloudToCanLatency");
+
+// Event counts; values carry the query attempt or the can id.
+const simsignal_t queryLostSignal = cComponent::registerSignal("queryLost");
+const simsignal_t responseLostSignal = cComponent::registerSignal("responseLost");
+const simsignal_t collectDispatchedSignal = cComponent::registerSignal("collectDispatched");
+const simsignal_t collectAckedSignal = cComponent::registerSignal("collectAcked");
+
+// Continuous fill model; counts carry the can id.
+const simsignal_t thresholdCrossedSignal = cComponent::registerSignal("thresholdCrossed");
+const simsignal_t overflowSignal = cComponent::registerSignal("overflow");
+const simsignal_t collectedVolumeSignal = cComponent::registerSignal("collectedVolume");
+const simsignal_t overflowDurationSignal = cComponent::registerSignal("overflowDuration");
+
+// Push mode: one per transmission, per ack and per notification given up on.
+const simsignal_t notifySentSignal = cComponent::registerSignal("notifySent");
+const simsignal_t notifyAckedSignal = cComponent::registerSignal("notifyAcked");
+const simsignal_t notifyFailedSignal = cComponent::registerSignal("notifyFailed");
+
+// Relative slack when comparing the level with the threshold or capacity, so
+// an event scheduled for the crossing is not lost to simtime rounding.
+const double kFillTolerance = 1e-9;
+
+/** Destinations of push notifications, used as index and timer kind. */
+enum NotifyTarget {
+    TO_COLLECTOR = 0,
+    TO_CLOUD = 1,
+    NOTIFY_TARGETS = 2
+};
 
-    throw cRuntimeError("%s: unable to locate text figure '%s'",
-        module->getFullPath().c_str(), name);
-}
+/** The latest state notification to one destination, until it is acked. */
+struct PendingNotification {
+    long seq = -1;               //!< Sequence number; -1 when nothing is outstanding.
+    int transmissions = 0;
+    cMessage *timer = nullptr;   //!< Retransmission timer.
+};
 
-/** Returns the status response command label for the given can id. */
-const char *kStatusCommandFor(int canId, bool isFull)
+/**
+ * Picks the legacy per-can name for can 0 or can 1. Cans beyond the original
+ * pair have no dedicated figures, so nullptr is returned.
+ */
+const char *perCanName(int canId, const char *canName, const char *anotherCanName)
 {
     if (canId == 0)
-        return isFull ? "3-YES" : "2-NO";
-    return isFull ? "6-YES" : "5-NO";
-}
-
-/** Returns the collect command that targets the given can id. */
-const char *kCollectCommandFor(int canId)
-{
-    return canId == 0 ? "7-Collect garbage" : "9-Collect garbage";
-}
-
-/** Increments an integer parameter on the parent module when present. */
-void incrementParentCounter(cModule *module, const char *parName)
-{
-    if (!module)
-        return;
-    if (cModule *parent = module->getParentModule()) {
-        if (parent->hasPar(parName)) {
-            const int current = parent->par(parName).intValue();
-            parent->par(parName).setIntValue(current + 1);
-        }
-    }
-}
-
-/** Writes an integer parameter on the parent module when present. */
-void setParentIntParameter(cModule *module, const char *parName, int value)
-{
-    if (!module)
-        return;
-    if (cModule *parent = module->getParentModule()) {
-        if (parent->hasPar(parName))
-            parent->par(parName).setIntValue(value);
-    }
+        return canName;
+    return canId == 1 ? anotherCanName : nullptr;
 }
 
 } // namespace
@@ -91,6 +76,23 @@ void setParentIntParameter(cModule *module, const char *parName, int value)
  * queries, optionally reporting directly to the cloud, and triggering
  * collect requests after repeated query losses. It keeps detailed counters
  * that are visualized both locally and on the parent module.
+ *
+ * With fillModel = "continuous" the can fills up over time instead of having
+ * a fixed hasGarbage flag. The level grows linearly at a rate redrawn from the
+ * fillRate distribution every fillRateInterval, so a can costs one event per
+ * rate change and per threshold or capacity crossing rather than one per
+ * time step. A collect acknowledgement empties the can.
+ *
+ * fillModel = "trace" fills the same way, but replays the can's fill-rate
+ * changes and deposits from a recorded FillTrace (e.g. bin sensor logs)
+ * instead of drawing them. The can keeps a cursor into the trace and only
+ * ever schedules its next trace event.
+ *
+ * With reportingMode = "push" the can does not wait to be polled: it notifies
+ * the collector and/or the cloud whenever its fill state changes, retransmits
+ * until the notification is acked, and otherwise only sends a heartbeat every
+ * heartbeatInterval. It still answers queries, which the collector falls back
+ * to when heartbeats stop.
  */
 class GarbageCan : public cSimpleModule {
   private:
@@ -99,55 +101,62 @@ class GarbageCan : public cSimpleModule {
     simtime_t responseDelay;
     bool reportStatusToCloud = false;
     bool sendCollectToCloud = false;
-    int lostQueryCount = 3;
     simtime_t collectDispatchDelay;
 
+    std::unique_ptr<LossModel> queryLoss;     //!< Collector-to-can direction of the fast link.
+    std::unique_ptr<LossModel> responseLoss;  //!< Can-to-collector direction of the fast link.
     int lostQueriesSeen = 0;
+    long queriesOffered = 0;
+    long responsesOffered = 0;
+    long responsesLost = 0;
     bool collectDispatched = false;
+    cMessage *collectRetryEvent = nullptr;  //!< Sends a collect the cloud turned away again.
+
+    bool continuousFill = false;
+    double capacity = 0;             //!< Litres.
+    double fullThreshold = 0;        //!< Fraction of capacity at which the can reports full.
+    simtime_t fillRateInterval;      //!< The fill rate is redrawn this often; 0 keeps the first draw.
+    double fillLevel = 0;            //!< Litres as of lastFillUpdate.
+    double fillRate = 0;             //!< Litres per second.
+    simtime_t lastFillUpdate;
+    simtime_t nextRateChange;
+    simtime_t overflowSince = -1;    //!< Time the can overflowed; negative while it has room.
+    simtime_t overflowTotal;         //!< Overflow time of finished overflow periods.
+    double collectedTotal = 0;       //!< Litres removed by collects.
+    cMessage *fillEvent = nullptr;
+    const FillTrace *fillTrace = nullptr;  //!< Replayed trace; nullptr unless fillModel is "trace".
+    uint64_t traceCursor = 0;        //!< Position of the next trace event to apply.
+    uint64_t traceEnd = 0;           //!< End of the can's events in the trace.
+    cMessage *traceEvent = nullptr;
+
+    bool pushMode = false;
+    bool notifyCollector = false;
+    bool notifyCloud = false;
+    simtime_t notifyTimeout;
+    int maxNotifyRetransmissions = 0;
+    simtime_t heartbeatInterval;     //!< 0 disables heartbeats.
+    long nextNotifySeq = 0;
+    PendingNotification pendingNotifications[NOTIFY_TARGETS];
+    cMessage *heartbeatEvent = nullptr;
+
+    std::string snapshotFile;        //!< Empty unless the fill state is saved.
+    cMessage *snapshotEvent = nullptr;
+
+    long collectorMessages = 0;      //!< Packets sent or received on the collector link, lost ones included.
+    long cloudMessages = 0;          //!< Packets sent or received on the cloud link.
 
     long sentFastTotal = 0;
     long rcvdFastTotal = 0;
     long lostFastTotal = 0;
 
-    std::map<std::string, long> sentFastMessages;
-    std::map<std::string, long> receivedFastMessages;
-    std::map<std::string, long> lostFastMessages;
+    MessageCounterTable sentFastMessages;
+    MessageCounterTable receivedFastMessages;
+    MessageCounterTable lostFastMessages;
 
     cTextFigure *counterFigure = nullptr;
+    mutable bool countersDirty = false;  //!< Counters changed since the figure was last rendered.
 
-    static void noteMessage(std::map<std::string, long> &bucket, const char *command)
-    {
-        const char *label = (command && *command) ? command : "<unknown>";
-        bucket[label]++;
-    }
-
-    static std::string describeMessages(const std::map<std::string, long> &bucket,
-        const std::map<std::string, long> *counterpart = nullptr)
-    {
-        if (bucket.empty())
-            return "  none";
-
-        std::ostringstream oss;
-        for (auto it = bucket.begin(); it != bucket.end(); ++it) {
-            const std::string &command = it->first;
-            const long count = it->second;
-            long counterpartCount = 0;
-            if (counterpart) {
-                auto found = counterpart->find(command);
-                if (found != counterpart->end())
-                    counterpartCount = found->second;
-            }
-            const long pending = counterpart ? (count - counterpartCount) : 0;
-            if (it != bucket.begin())
-                oss << "\n";
-            oss << "  " << command << " x" << count;
-            if (counterpart && counterpartCount > 0)
-                oss << " (matched " << counterpartCount << ")";
-            if (counterpart && pending > 0)
-                oss << " (pending " << pending << ")";
-        }
-        return oss.str();
-    }
+    int inCloudGateId = -1;
 
     std::string formatStatusText() const
     {
@@ -159,111 +168,383 @@ class GarbageCan : public cSimpleModule {
         return oss.str();
     }
 
-    bool isQueryCommand(const char *command) const
-    {
-        return strcmp(command, "1-Is the can full?") == 0 || strcmp(command, "4-Is the can full?") == 0;
-    }
-
-    bool isCollectAckCommand(const char *command) const
-    {
-        return strcmp(command, "8-OK") == 0 || strcmp(command, "10-OK") == 0;
-    }
-
-    bool isCloudStatusAckCommand(const char *command) const
-    {
-        return strcmp(command, "cloud-ack") == 0;
-    }
-
-    void recordSentFast(const char *command)
+    void recordSentFast(const GarbagePacket *pkt)
     {
         ++sentFastTotal;
-        noteMessage(sentFastMessages, command);
-        updateCounterFigure();
+        sentFastMessages.note(pkt);
+        countersDirty = true;
     }
 
-    void recordRcvdFast(const char *command)
+    void recordRcvdFast(const GarbagePacket *pkt)
     {
         ++rcvdFastTotal;
-        noteMessage(receivedFastMessages, command);
-        updateCounterFigure();
+        receivedFastMessages.note(pkt);
+        countersDirty = true;
     }
 
-    void recordLostFast(const char *command)
+    void recordLostFast(const GarbagePacket *pkt)
     {
         ++lostFastTotal;
-        noteMessage(lostFastMessages, command);
-        updateCounterFigure();
+        lostFastMessages.note(pkt);
+        countersDirty = true;
     }
 
-    void updateCounterFigure()
+    /** Re-renders the counter figure; only called from refreshDisplay(). */
+    void updateCounterFigure() const
     {
-        if (!counterFigure)
+        if (!counterFigure || !countersDirty)
             return;
 
+        countersDirty = false;
         counterFigure->setVisible(true);
-        const std::string text = formatStatusText();
-        counterFigure->setText(text.c_str());
-        if (cModule *parent = getParentModule()) {
-            const char *parName = (canId == 0) ? "canCountersText" : "anotherCanCountersText";
-            if (parent->hasPar(parName))
-                parent->par(parName).setStringValue(text.c_str());
+        counterFigure->setText(formatStatusText().c_str());
+    }
+
+    /**
+     * Sends a packet on a collector link through the response loss model;
+     * link 0 leads to the owning collector. Returns false, with the packet
+     * deleted, when the loss model dropped it.
+     */
+    bool sendToCollector(GarbagePacket *pkt, simtime_t delay, int link = 0)
+    {
+        ++collectorMessages;
+        ++responsesOffered;
+        if (responseLoss->dropNext()) {
+            ++responsesLost;
+            recordLostFast(pkt);
+            delete pkt;
+            return false;
         }
+        sendDelayed(pkt, delay, "out", link);
+        return true;
     }
 
-    void dispatchStatus()
+    void sendToCloud(GarbagePacket *pkt, simtime_t delay)
+    {
+        ++cloudMessages;
+        sendDelayed(pkt, delay, "outCloud");
+    }
+
+    /**
+     * Answers a query on the link it arrived on; the attempt number is echoed
+     * so the collector can time it. The reply to the collector passes through
+     * the response loss model.
+     */
+    void dispatchStatus(int queryAttempt, int link)
     {
         auto *reply = new GarbagePacket(hasGarbage ? "Yes" : "No");
-        reply->setCommand(kStatusCommandFor(canId, hasGarbage));
+        reply->setOpcode(statusOpcode(hasGarbage));
         reply->setCanId(canId);
         reply->setIsFull(hasGarbage);
         reply->setTravelTime(SIMTIME_DBL(responseDelay));
+        reply->setAttempt(queryAttempt);
+        reply->setTimestamp();
 
-        recordSentFast(reply->getCommand());
-        sendDelayed(reply, responseDelay, "out");
-
+        recordSentFast(reply);
         if (reportStatusToCloud && gate("outCloud")->isConnected()) {
             auto *cloudReport = reply->dup();
             cloudReport->setName("garbage-status-cloud");
             cloudReport->setNote("direct-report");
-            recordSentFast(cloudReport->getCommand());
-            sendDelayed(cloudReport, responseDelay, "outCloud");
+            recordSentFast(cloudReport);
+            sendToCloud(cloudReport, responseDelay);
+        }
+
+        if (!sendToCollector(reply, responseDelay, link)) {
+            emit(responseLostSignal, queryAttempt);
+            EV_INFO << "GarbageCan " << canId << " lost its response to query attempt " << queryAttempt << endl;
         }
     }
 
+    void drawFillRate()
+    {
+        fillRate = std::max(0.0, par("fillRate").doubleValue()) / 3600;
+        nextRateChange = simTime() + fillRateInterval;
+    }
+
+    /** Brings the level up to the current time and notes threshold and capacity crossings. */
+    void advanceFill()
+    {
+        const simtime_t now = simTime();
+        fillLevel = std::min(capacity, fillLevel + fillRate * SIMTIME_DBL(now - lastFillUpdate));
+        lastFillUpdate = now;
+
+        if (!hasGarbage && fillLevel >= fullThreshold * capacity * (1 - kFillTolerance)) {
+            hasGarbage = true;
+            emit(thresholdCrossedSignal, canId);
+            EV_INFO << "GarbageCan " << canId << " reached its fill threshold" << endl;
+        }
+        if (overflowSince < SIMTIME_ZERO && fillLevel >= capacity * (1 - kFillTolerance)) {
+            overflowSince = now;
+            emit(overflowSignal, canId);
+            EV_INFO << "GarbageCan " << canId << " is overflowing" << endl;
+        }
+    }
+
+    /** Schedules the next rate change or crossing, whichever comes first. */
+    void scheduleFillEvent()
+    {
+        const simtime_t now = simTime();
+        simtime_t next = fillRateInterval > SIMTIME_ZERO ? nextRateChange : SimTime::getMaxTime();
+
+        auto considerCrossing = [&](double target) {
+            const double delay = (target - fillLevel) / fillRate;
+            if (delay < SIMTIME_DBL(next - now))
+                next = now + std::max(SimTime(std::max(delay, 0.0)), SimTime::fromRaw(1));
+        };
+        if (fillRate > 0) {
+            if (!hasGarbage)
+                considerCrossing(fullThreshold * capacity);
+            if (overflowSince < SIMTIME_ZERO)
+                considerCrossing(capacity);
+        }
+
+        if (next < SimTime::getMaxTime())
+            scheduleAt(next, fillEvent);
+    }
+
+    void handleFillEvent()
+    {
+        const bool wasFull = hasGarbage;
+        advanceFill();
+        if (pushMode && hasGarbage != wasFull)
+            notifyStateChange();
+        if (fillRateInterval > SIMTIME_ZERO && simTime() >= nextRateChange)
+            drawFillRate();
+        scheduleFillEvent();
+    }
+
+    /** Schedules the next event of the can's trace, if it has one left. */
+    void scheduleTraceEvent()
+    {
+        if (traceCursor == traceEnd)
+            return;
+        const double time = fillTrace->event(traceCursor).time;
+        if (time < SIMTIME_DBL(simTime()))
+            throw cRuntimeError("Fill trace event of can %d at %gs is in the past (events must be in time order)", canId, time);
+        scheduleAt(time, traceEvent);
+    }
+
+    void handleTraceEvent()
+    {
+        const FillTrace::Event &event = fillTrace->event(traceCursor++);
+        const bool wasFull = hasGarbage;
+        advanceFill();
+        switch (event.kind) {
+            case FillTrace::EVENT_FILL_RATE:
+                fillRate = std::max(0.0, event.value) / 3600;
+                break;
+            case FillTrace::EVENT_DEPOSIT:
+                // Whatever does not fit any more is lost, as with continuous filling.
+                fillLevel = std::min(capacity, fillLevel + std::max(0.0, event.value));
+                advanceFill();
+                break;
+            default:
+                throw cRuntimeError("Unknown fill trace event kind %u for can %d", event.kind, canId);
+        }
+        if (pushMode && hasGarbage != wasFull)
+            notifyStateChange();
+        cancelEvent(fillEvent);
+        scheduleFillEvent();
+        scheduleTraceEvent();
+    }
+
+    /** A collect was confirmed: the can is emptied and starts filling again. */
+    void emptyCan()
+    {
+        advanceFill();
+        emit(collectedVolumeSignal, fillLevel);
+        collectedTotal += fillLevel;
+        if (overflowSince >= SIMTIME_ZERO) {
+            const simtime_t overflowDuration = simTime() - overflowSince;
+            emit(overflowDurationSignal, overflowDuration);
+            overflowTotal += overflowDuration;
+            overflowSince = -1;
+        }
+
+        EV_INFO << "GarbageCan " << canId << " emptied (" << fillLevel << " litres)" << endl;
+        fillLevel = 0;
+        hasGarbage = false;
+        collectDispatched = false;
+        cancelEvent(fillEvent);
+        scheduleFillEvent();
+        if (pushMode)
+            notifyStateChange();
+    }
+
+    bool notifies(int target) const
+    {
+        return target == TO_CLOUD ? notifyCloud : notifyCollector;
+    }
+
+    /** Sends the current fill state under the pending sequence number and arms the retransmission timer. */
+    void transmitNotification(int target)
+    {
+        PendingNotification &pending = pendingNotifications[target];
+        auto *notify = new GarbagePacket(hasGarbage ? "notify-full" : "notify-empty");
+        notify->setOpcode(OP_NOTIFY);
+        notify->setCanId(canId);
+        notify->setIsFull(hasGarbage);
+        notify->setRequestId(pending.seq);
+        notify->setAttempt(++pending.transmissions);
+        notify->setTimestamp();
+
+        recordSentFast(notify);
+        emit(notifySentSignal, canId);
+        if (target == TO_CLOUD)
+            sendToCloud(notify, SIMTIME_ZERO);
+        else
+            sendToCollector(notify, SIMTIME_ZERO);
+        scheduleAfter(notifyTimeout, pending.timer);
+    }
+
+    /** Reports a fill-state change; it supersedes any notification still awaiting its ack. */
+    void notifyStateChange()
+    {
+        for (int target = 0; target < NOTIFY_TARGETS; ++target) {
+            if (!notifies(target))
+                continue;
+            PendingNotification &pending = pendingNotifications[target];
+            cancelEvent(pending.timer);
+            pending.seq = nextNotifySeq++;
+            pending.transmissions = 0;
+            transmitNotification(target);
+        }
+        if (hasGarbage)
+            dispatchCollectIfNeeded();
+    }
+
+    void handleNotifyTimeout(cMessage *timer)
+    {
+        const int target = timer->getKind();
+        PendingNotification &pending = pendingNotifications[target];
+        if (pending.transmissions > maxNotifyRetransmissions) {
+            EV_WARN << "GarbageCan " << canId << " gave up on notification " << pending.seq
+                    << " after " << pending.transmissions << " transmissions" << endl;
+            emit(notifyFailedSignal, canId);
+            pending.seq = -1;
+            return;
+        }
+        transmitNotification(target);
+    }
+
+    void handleNotifyAck(GarbagePacket *pkt, bool fromCloud)
+    {
+        PendingNotification &pending = pendingNotifications[fromCloud ? TO_CLOUD : TO_COLLECTOR];
+        if (pending.seq < 0 || pkt->getRequestId() != pending.seq)
+            return;  // ack of a superseded notification or a duplicate
+        cancelEvent(pending.timer);
+        pending.seq = -1;
+        emit(notifyAckedSignal, canId);
+    }
+
+    /** Unacknowledged liveness report; lets the collector skip polling this can. */
+    void sendHeartbeat()
+    {
+        if (continuousFill)
+            advanceFill();
+        for (int target = 0; target < NOTIFY_TARGETS; ++target) {
+            if (!notifies(target))
+                continue;
+            auto *heartbeat = new GarbagePacket("heartbeat");
+            heartbeat->setOpcode(OP_HEARTBEAT);
+            heartbeat->setCanId(canId);
+            heartbeat->setIsFull(hasGarbage);
+            heartbeat->setTimestamp();
+            recordSentFast(heartbeat);
+            if (target == TO_CLOUD)
+                sendToCloud(heartbeat, SIMTIME_ZERO);
+            else
+                sendToCollector(heartbeat, SIMTIME_ZERO);
+        }
+        scheduleAfter(heartbeatInterval, heartbeatEvent);
+    }
+
     void dispatchCollectIfNeeded()
     {
         if (!sendCollectToCloud || collectDispatched || !hasGarbage || !gate("outCloud")->isConnected())
             return;
 
         auto *collect = new GarbagePacket("Collect can garbage");
-        collect->setCommand(kCollectCommandFor(canId));
+        collect->setOpcode(OP_COLLECT);
         collect->setCanId(canId);
         collect->setIsFull(true);
         collect->setTravelTime(SIMTIME_DBL(collectDispatchDelay));
         collect->setNote("fog-direct");
-        recordSentFast(collect->getCommand());
-        sendDelayed(collect, collectDispatchDelay, "outCloud");
-        incrementParentCounter(this, canId == 0 ? "canCollectCount" : "anotherCanCollectCount");
+        collect->setTimestamp();
+        recordSentFast(collect);
+        sendToCloud(collect, collectDispatchDelay);
+        emit(collectDispatchedSignal, canId);
         collectDispatched = true;
         EV_INFO << "Can " << canId << " dispatched collect request to cloud" << endl;
     }
 
-    void handleQuery(GarbagePacket *pkt)
+    /**
+     * The cloud's queue was full. A rejected notification or collect is sent
+     * again after the retry hint; statuses and heartbeats are not repeated.
+     */
+    void handleCloudBusy(GarbagePacket *pkt)
+    {
+        const auto *rejected = dynamic_cast<const GarbagePacket *>(pkt->getEncapsulatedPacket());
+        if (!rejected)
+            return;
+        const simtime_t hint = pkt->getTravelTime();
+        if (rejected->getOpcode() == OP_NOTIFY) {
+            PendingNotification &pending = pendingNotifications[TO_CLOUD];
+            if (rejected->getRequestId() == pending.seq) {
+                cancelEvent(pending.timer);
+                scheduleAfter(hint, pending.timer);
+            }
+        }
+        else if (rejected->getOpcode() == OP_COLLECT && collectDispatched && !collectRetryEvent->isScheduled()) {
+            collectDispatched = false;
+            scheduleAfter(hint, collectRetryEvent);
+        }
+    }
+
+    /** Backpressure from the cloud: the next heartbeat waits for the retry hint. */
+    void handleBackpressure(GarbagePacket *pkt)
     {
-        const char *command = pkt->getCommand();
+        const simtime_t resumeAt = simTime() + pkt->getTravelTime();
+        if (heartbeatEvent && heartbeatEvent->isScheduled() && heartbeatEvent->getArrivalTime() < resumeAt) {
+            cancelEvent(heartbeatEvent);
+            scheduleAt(resumeAt, heartbeatEvent);
+        }
+    }
 
-        if (lostQueriesSeen < lostQueryCount) {
+    void takeSnapshot()
+    {
+        if (continuousFill)
+            advanceFill();
+        FleetSnapshot::CanRecord record = {};
+        record.fillLevel = fillLevel;
+        record.fillRate = fillRate;
+        record.nextNotifySeq = nextNotifySeq;
+        record.hasGarbage = hasGarbage;
+        record.overflowing = overflowSince >= SIMTIME_ZERO;
+        FleetSnapshot &snapshot = FleetSnapshot::open(snapshotFile, par("numCans"), FleetSnapshot::Mode::Write);
+        snapshot.stamp(SIMTIME_DBL(simTime()));
+        snapshot.putCan(canId, record);
+    }
+
+    void handleQuery(GarbagePacket *pkt)
+    {
+        ++queriesOffered;
+        if (queryLoss->dropNext()) {
             ++lostQueriesSeen;
+            emit(queryLostSignal, pkt->getAttempt());
             EV_INFO << "GarbageCan " << canId << " dropping query attempt " << lostQueriesSeen << endl;
-            bubble("Lost Message");
-            recordLostFast(command);
+            if (figuresEnabled())
+                bubble("Lost Message");
+            recordLostFast(pkt);
             delete pkt;
             return;
         }
 
-        recordRcvdFast(command);
+        recordRcvdFast(pkt);
         EV_INFO << "GarbageCan " << canId << " processing query command" << endl;
-        dispatchStatus();
+        if (continuousFill)
+            advanceFill();
+        dispatchStatus(pkt->getAttempt(), pkt->getArrivalGate()->getIndex());
         dispatchCollectIfNeeded();
         delete pkt;
     }
@@ -276,48 +557,193 @@ class GarbageCan : public cSimpleModule {
         responseDelay = par("responseDelay");
         reportStatusToCloud = par("reportStatusToCloud");
         sendCollectToCloud = par("sendCollectToCloud");
-        lostQueryCount = par("lostQueryCount");
         collectDispatchDelay = par("collectDispatchDelay");
+        inCloudGateId = gate("inCloud")->getId();
+        collectRetryEvent = new cMessage("collect-retry");
+
+        const double linkDistance = std::hypot(par("posX").doubleValue() - par("collectorX").doubleValue(),
+            par("posY").doubleValue() - par("collectorY").doubleValue());
+        queryLoss = createLossModel(this, true, linkDistance);
+        responseLoss = createLossModel(this, false, linkDistance);
+
+        // A warm start replaces the initial fill state with the snapshot's.
+        const FleetSnapshot::CanRecord *warmState = nullptr;
+        const std::string warmStartFile = par("warmStartFile").stdstringValue();
+        if (!warmStartFile.empty())
+            warmState = FleetSnapshot::open(warmStartFile, par("numCans"), FleetSnapshot::Mode::Read).findCan(canId);
 
         std::string communicationMode;
         if (cModule *parent = getParentModule()) {
             if (parent->hasPar("communicationMode"))
                 communicationMode = parent->par("communicationMode").stdstringValue();
         }
-        if (communicationMode == "GarbageInTheCansAndSlow" || communicationMode == "GarbageInTheCansAndFast")
+        const std::string fillModel = par("fillModel").stdstringValue();
+        continuousFill = fillModel == "continuous" || fillModel == "trace";
+        if (!continuousFill && fillModel != "static")
+            throw cRuntimeError("Unknown fillModel '%s' (expected \"static\", \"continuous\" or \"trace\")", fillModel.c_str());
+
+        if (!continuousFill && (communicationMode == "GarbageInTheCansAndSlow" || communicationMode == "GarbageInTheCansAndFast"))
             hasGarbage = true;
         if (communicationMode == "GarbageInTheCansAndFast")
             sendCollectToCloud = true;
         else if (communicationMode == "GarbageInTheCansAndSlow")
             sendCollectToCloud = false;
+        if (warmState) {
+            hasGarbage = warmState->hasGarbage;
+            nextNotifySeq = warmState->nextNotifySeq;
+        }
 
-        counterFigure = requireTextFigure(this, canId == 0 ? "canCounters" : "anotherCanCounters");
-        updateCounterFigure();
+        if (continuousFill) {
+            capacity = par("capacity");
+            fullThreshold = par("fullThreshold");
+            fillRateInterval = par("fillRateInterval");
+            if (capacity <= 0)
+                throw cRuntimeError("capacity must be positive, got %g", capacity);
+            if (fullThreshold <= 0 || fullThreshold > 1)
+                throw cRuntimeError("fullThreshold must be in (0, 1], got %g", fullThreshold);
+            if (fillModel == "trace") {
+                // The trace sets the rate; nothing is drawn.
+                fillTrace = &FillTrace::open(par("fillTrace").stdstringValue());
+                if (canId >= fillTrace->numCans())
+                    throw cRuntimeError("Can %d is not in the %d-can fill trace", canId, fillTrace->numCans());
+                traceCursor = fillTrace->firstEvent(canId);
+                traceEnd = fillTrace->firstEvent(canId + 1);
+                traceEvent = new cMessage("trace");
+                fillRateInterval = SIMTIME_ZERO;
+            }
+
+            lastFillUpdate = simTime();
+            fillEvent = new cMessage("fill");
+            if (warmState) {
+                // The crossings before the snapshot are not signalled again.
+                fillLevel = std::min(capacity, warmState->fillLevel);
+                fillRate = warmState->fillRate;
+                nextRateChange = simTime() + fillRateInterval;
+                overflowSince = warmState->overflowing ? simTime() : SimTime(-1);
+            }
+            else {
+                hasGarbage = false;
+                fillLevel = std::min(1.0, std::max(0.0, par("initialFill").doubleValue())) * capacity;
+                if (!fillTrace)
+                    drawFillRate();
+            }
+            advanceFill();
+            scheduleFillEvent();
+            if (fillTrace)
+                scheduleTraceEvent();
+        }
+
+        const std::string reportingMode = par("reportingMode").stdstringValue();
+        pushMode = reportingMode == "push";
+        if (!pushMode && reportingMode != "poll")
+            throw cRuntimeError("Unknown reportingMode '%s' (expected \"poll\" or \"push\")", reportingMode.c_str());
+        if (pushMode) {
+            const std::string target = par("notifyTarget").stdstringValue();
+            if (target != "collector" && target != "cloud" && target != "both")
+                throw cRuntimeError("Unknown notifyTarget '%s' (expected \"collector\", \"cloud\" or \"both\")", target.c_str());
+            notifyCollector = target != "cloud" && gateSize("out") > 0 && gate("out", 0)->isConnected();
+            notifyCloud = target != "collector" && gate("outCloud")->isConnected();
+            notifyTimeout = par("notifyTimeout");
+            maxNotifyRetransmissions = par("maxNotifyRetransmissions");
+            heartbeatInterval = par("heartbeatInterval");
+            for (int target = 0; target < NOTIFY_TARGETS; ++target)
+                pendingNotifications[target].timer = new cMessage("notify-timeout", target);
+
+            if (hasGarbage)
+                notifyStateChange();
+            if (heartbeatInterval > SIMTIME_ZERO) {
+                // Spread the fleet's heartbeats over the interval.
+                heartbeatEvent = new cMessage("heartbeat");
+                scheduleAfter(uniform(0, SIMTIME_DBL(heartbeatInterval)), heartbeatEvent);
+            }
+        }
+
+        snapshotFile = par("snapshotFile").stdstringValue();
+        const simtime_t snapshotAt = par("snapshotAt");
+        if (!snapshotFile.empty() && snapshotAt >= SIMTIME_ZERO) {
+            snapshotEvent = new cMessage("snapshot");
+            scheduleAt(snapshotAt, snapshotEvent);
+        }
+
+        if (const char *figureName = perCanName(canId, "canCounters", "anotherCanCounters")) {
+            counterFigure = findTextFigure(this, figureName);
+            countersDirty = true;
+        }
     }
 
     void handleMessage(cMessage *msg) override
     {
-        auto *pkt = check_and_cast<GarbagePacket *>(msg);
-        const char *command = pkt->getCommand();
-
-        if (isQueryCommand(command)) {
-            handleQuery(pkt);
+        if (msg == fillEvent) {
+            handleFillEvent();
             return;
         }
-
-        if (isCollectAckCommand(command)) {
-            recordRcvdFast(command);
-            EV_INFO << "Cloud acknowledged collect request for can " << canId
-                    << ": " << (pkt->getNote() ? pkt->getNote() : "") << endl;
-            incrementParentCounter(this, canId == 0 ? "canCollectAckCount" : "anotherCanCollectAckCount");
+        if (msg == traceEvent) {
+            handleTraceEvent();
+            return;
+        }
+        if (msg == heartbeatEvent) {
+            sendHeartbeat();
+            return;
+        }
+        if (msg == snapshotEvent) {
+            takeSnapshot();
+            return;
+        }
+        if (msg == collectRetryEvent) {
+            dispatchCollectIfNeeded();
+            return;
         }
-        else if (isCloudStatusAckCommand(command)) {
-            recordRcvdFast(command);
-            EV_INFO << "Cloud acknowledged status for can " << canId
-                    << ": " << (pkt->getNote() ? pkt->getNote() : "") << endl;
+        if (msg->isSelfMessage()) {
+            handleNotifyTimeout(msg);
+            return;
         }
-        else {
-            EV_WARN << "GarbageCan " << canId << " received unknown command '" << command << "'" << endl;
+
+        auto *pkt = check_and_cast<GarbagePacket *>(msg);
+        const bool fromCloud = pkt->getArrivalGateId() == inCloudGateId;
+        ++(fromCloud ? cloudMessages : collectorMessages);
+        emit(fromCloud ? cloudToCanLatencySignal : hostToCanLatencySignal, simTime() - pkt->getTimestamp(), pkt);
+
+        switch (pkt->getOpcode()) {
+            case OP_QUERY:
+                handleQuery(pkt);
+                return;
+            case OP_COLLECT_ACK:
+                recordRcvdFast(pkt);
+                EV_INFO << "Cloud acknowledged collect request for can " << canId
+                        << ": " << (pkt->getNote() ? pkt->getNote() : "") << endl;
+                emit(collectAckedSignal, canId);
+                if (continuousFill)
+                    emptyCan();
+                break;
+            case OP_NOTIFY_ACK:
+                if (!fromCloud) {
+                    // Acks share the collector-to-can direction of the link with queries.
+                    ++queriesOffered;
+                    if (queryLoss->dropNext()) {
+                        ++lostQueriesSeen;
+                        recordLostFast(pkt);
+                        break;
+                    }
+                }
+                recordRcvdFast(pkt);
+                handleNotifyAck(pkt, fromCloud);
+                break;
+            case OP_CLOUD_ACK:
+                recordRcvdFast(pkt);
+                EV_INFO << "Cloud acknowledged status for can " << canId
+                        << ": " << (pkt->getNote() ? pkt->getNote() : "") << endl;
+                break;
+            case OP_CLOUD_BUSY:
+                recordRcvdFast(pkt);
+                handleCloudBusy(pkt);
+                break;
+            case OP_BACKPRESSURE:
+                recordRcvdFast(pkt);
+                handleBackpressure(pkt);
+                break;
+            default:
+                EV_WARN << "GarbageCan " << canId << " received unknown command '" << commandLabel(pkt) << "'" << endl;
+                break;
         }
 
         delete pkt;
@@ -325,14 +751,48 @@ class GarbageCan : public cSimpleModule {
 
     void refreshDisplay() const override
     {
-        const_cast<GarbageCan *>(this)->updateCounterFigure();
+        updateCounterFigure();
     }
 
     void finish() override
     {
-        setParentIntParameter(this,
-            canId == 0 ? "canLostQueriesFinal" : "anotherCanLostQueriesFinal",
-            lostQueriesSeen);
+        if (!snapshotFile.empty() && !snapshotEvent)
+            takeSnapshot();  // no snapshotAt: the state at the end of the run
+
+        // Per-loss counts are recorded through the queryLost/responseLost statistics.
+        recordScalar("lossQueriesOffered", queriesOffered);
+        recordScalar("lossResponsesOffered", responsesOffered);
+        recordScalar("lossNominalRate", queryLoss->nominalLossRate());
+        const long offered = queriesOffered + responsesOffered;
+        if (offered > 0)
+            recordScalar("lossMeasuredRate", double(lostQueriesSeen + responsesLost) / offered);
+
+        if (continuousFill) {
+            advanceFill();
+            const simtime_t overflowing = overflowTotal + (overflowSince >= SIMTIME_ZERO ? simTime() - overflowSince : SIMTIME_ZERO);
+            recordScalar("fillLevel", fillLevel / capacity);
+            recordScalar("collectedVolume", collectedTotal);
+            recordScalar("overflowTime", overflowing);
+        }
+
+        // Radio and cloud ingress load of this can, comparable between poll and push mode.
+        const double hours = SIMTIME_DBL(simTime()) / 3600;
+        if (hours > 0) {
+            recordScalar("collectorMessagesPerHour", collectorMessages / hours);
+            recordScalar("cloudMessagesPerHour", cloudMessages / hours);
+        }
+    }
+
+  public:
+    ~GarbageCan() override
+    {
+        cancelAndDelete(fillEvent);
+        cancelAndDelete(traceEvent);
+        cancelAndDelete(heartbeatEvent);
+        cancelAndDelete(collectRetryEvent);
+        cancelAndDelete(snapshotEvent);
+        for (PendingNotification &pending : pendingNotifications)
+            cancelAndDelete(pending.timer);
     }
 };
 Define_Module(GarbageCan);
@@ -1,12 +1,16 @@
 #include <omnetpp.h>
 #include <algorithm>
-#include <array>
+#include <cmath>
+#include <cstdint>
 #include <deque>
-#include <cstring>
-#include <functional>
-#include <map>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <vector>
+#include "CommandLabels.h"
+#include "FigureRegistry.h"
+#include "FleetSnapshot.h"
+#include "MessageCounters.h"
 #include "messages_m.h"
 
 using namespace omnetpp;
@@ -14,115 +18,75 @@ using namespace garbage_collection;
 
 namespace {
 
-/**
- * Finds and returns a named text figure attached to the parent canvas.
- * Throws if the figure is missing so the simulation fails fast.
- */
-cTextFigure *requireTextFigure(cModule *module, const char *name)
-{
-    if (!module)
-        throw cRuntimeError("Null module while searching for figure '%s'", name);
-
-    cCanvas *canvas = module->getParentModule()->getCanvas();
-    if (!canvas)
-        throw cRuntimeError("%s: canvas unavailable while searching for figure '%s'",
-            module->getFullPath().c_str(), name);
-
-    std::function<cTextFigure *(cFigure *)> search = [&](cFigure *figure) -> cTextFigure * {
-        if (!figure)
-            return nullptr;
-        if (strcmp(figure->getName(), name) == 0)
-            return dynamic_cast<cTextFigure *>(figure);
-        for (int i = 0; i < figure->getNumFigures(); ++i) {
-            if (auto *child = search(figure->getFigure(i)))
-                return child;
-        }
-        return nullptr;
-    };
-
-    if (auto *result = search(canvas->getRootFigure()))
-        return result;
-
-    throw cRuntimeError("%s: unable to locate text figure '%s'",
-        module->getFullPath().c_str(), name);
-}
-
-/** Returns the status query command targeting the provided can id. */
-const char *kQueryCommandFor(int canId)
-{
-    return canId == 0 ? "1-Is the can full?" : "4-Is the can full?";
-}
-
-/** Returns the collect request command targeting the provided can id. */
-const char *kCollectCommandFor(int canId)
-{
-    return canId == 0 ? "7-Collect garbage" : "9-Collect garbage";
-}
-
-/** Returns the collect acknowledgement command expected from the cloud. */
-const char *kCollectAckCommandFor(int canId)
-{
-    return canId == 0 ? "8-OK" : "10-OK";
-}
-
-/** Returns the base name of the fast input gate for the given can id. */
-const char *kInGateBaseNameFor(int canId)
-{
-    return canId == 0 ? "inCan" : "inAnotherCan";
-}
-
-/** Returns the name of the fast output gate for the given can id. */
-const char *kOutGateNameFor(int canId)
-{
-    return canId == 0 ? "outCan" : "outAnotherCan";
-}
-
-/** Returns true when the command string denotes a status response. */
-bool isStatusCommand(const std::string &command)
-{
-    return command == "2-NO" || command == "3-YES" || command == "5-NO" || command == "6-YES";
-}
+// One-way latencies measured on arrival, and round trips closed by a reply.
+const simsignal_t canToHostLatencySignal = cComponent::registerSignal("canToHostLatency");
+const simsignal_t cloudToHostLatencySignal = cComponent::registerSignal("cloudToHostLatency");
+const simsignal_t queryRoundTripSignal = cComponent::registerSignal("queryRoundTrip");
+const simsignal_t collectRoundTripSignal = cComponent::registerSignal("collectRoundTrip");
+
+// Event counts; each carries the can id so vectors show which can was involved.
+const simsignal_t collectSentSignal = cComponent::registerSignal("collectSent");
+const simsignal_t collectAckedSignal = cComponent::registerSignal("collectAcked");
+const simsignal_t queryAttemptsSignal = cComponent::registerSignal("queryAttempts");
 
 /**
- * Determines whether a command string matches a collect acknowledgement and
- * outputs the corresponding can id via the canId parameter.
+ * Per-can collector bookkeeping laid out as parallel arrays indexed by can id,
+ * so sweeps over the fleet touch one dense column instead of scattered objects.
  */
-bool isCollectAckCommand(const std::string &command, int &canId)
-{
-    if (command == kCollectAckCommandFor(0)) {
-        canId = 0;
-        return true;
-    }
-    if (command == kCollectAckCommandFor(1)) {
-        canId = 1;
-        return true;
-    }
-    return false;
-}
-
-/** Increments an integer parameter on the parent module when available. */
-void incrementParentCounter(cModule *module, const char *parName)
-{
-    if (!module)
-        return;
-    if (cModule *parent = module->getParentModule()) {
-        if (parent->hasPar(parName)) {
-            const int current = parent->par(parName).intValue();
-            parent->par(parName).setIntValue(current + 1);
-        }
-    }
-}
-
-/** Writes an integer parameter on the parent module when available. */
-void setParentIntParameter(cModule *module, const char *parName, int value)
-{
-    if (!module)
-        return;
-    if (cModule *parent = module->getParentModule()) {
-        if (parent->hasPar(parName))
-            parent->par(parName).setIntValue(value);
-    }
-}
+struct CanTable {
+    std::vector<int8_t> states;               //!< kUnknownState, 0 (empty) or 1 (full).
+    std::vector<int> attempts;                //!< Query attempts issued so far.
+    std::vector<uint8_t> awaitingCollectAck;  //!< Collect sent, cloud ack outstanding.
+    std::vector<uint8_t> collectSent;         //!< Collect queued or sent for this can.
+    std::vector<uint8_t> inspecting;          //!< Holds a fan-out concurrency slot.
+    std::vector<uint8_t> abandoned;           //!< Gave up after maxQueryAttempts.
+    std::vector<simtime_t> querySentAt;       //!< Send time of the latest query attempt.
+    std::vector<double> srtt;                 //!< Smoothed round-trip time in seconds; negative before the first sample.
+    std::vector<double> rttvar;               //!< Round-trip time variation in seconds.
+    std::vector<simtime_t> rto;               //!< Base retransmission timeout before backoff.
+    std::vector<CanTimer *> retryEvents;      //!< Lazily allocated retry timers.
+    std::vector<simtime_t> lastHeard;         //!< Push mode: last notification, heartbeat or status.
+    std::vector<long> lastNotifySeq;          //!< Push mode: highest notification sequence applied.
+    std::vector<uint8_t> assigned;            //!< This collector inspects the can in the current round.
+    std::vector<uint8_t> takenOver;           //!< Assigned by a peer this round; never handed on.
+    std::vector<int> workIndex;               //!< Position in the work list, or -1.
+
+    void resize(int count, int8_t unknownState, simtime_t initialRto)
+    {
+        states.assign(count, unknownState);
+        attempts.assign(count, 0);
+        awaitingCollectAck.assign(count, 0);
+        collectSent.assign(count, 0);
+        inspecting.assign(count, 0);
+        abandoned.assign(count, 0);
+        querySentAt.assign(count, SIMTIME_ZERO);
+        srtt.assign(count, -1.0);
+        rttvar.assign(count, 0.0);
+        rto.assign(count, initialRto);
+        retryEvents.assign(count, nullptr);
+        lastHeard.assign(count, SIMTIME_ZERO);
+        lastNotifySeq.assign(count, -1);
+        assigned.assign(count, 0);
+        takenOver.assign(count, 0);
+        workIndex.assign(count, -1);
+    }
+
+    int size() const { return static_cast<int>(states.size()); }
+};
+
+/** A collect request sent to the cloud whose ack is still outstanding. */
+struct InFlightCollect {
+    int canId = -1;
+    int transmissions = 0;              //!< Original send plus retransmissions.
+    simtime_t firstSentAt;              //!< Send time of the original transmission.
+    CollectTimer *timeout = nullptr;    //!< Retransmission timer; null when collectTimeout is 0.
+};
+
+/** Order in which the collector inspects the cans. */
+enum class InspectionStrategy {
+    Serial,  //!< can i+1 is queried only after can i answered (and, when slow, its collect was acked).
+    Fanout,  //!< All cans are queried concurrently, up to fanoutConcurrency at a time.
+};
 
 } // namespace
 
@@ -132,24 +96,68 @@ void setParentIntParameter(cModule *module, const char *parName, int value)
  */
 class GarbageCollector : public cSimpleModule {
   private:
-    static constexpr int kCanCount = 2;
-    static constexpr int kUnknownState = -1;
+    static constexpr int8_t kUnknownState = -1;
 
     cMessage *startEvent = nullptr;
-    std::array<cMessage *, kCanCount> retryEvents {nullptr, nullptr};
-    std::array<int, kCanCount> canStates {kUnknownState, kUnknownState};
-    std::array<int, kCanCount> attemptCounters {0, 0};
-    std::array<bool, kCanCount> awaitingCollectAck {false, false};
-    std::array<bool, kCanCount> collectSent {false, false};
+    CanTable cans;
+    int knownCans = 0;
     std::deque<int> collectQueue;
-    bool pendingSecondCanQuery = false;
+    std::unordered_map<long, InFlightCollect> inFlightCollects;  //!< Keyed by request id.
+    long nextCollectRequestId = 0;
+    int deferringCan = -1;  //!< Serial mode: can whose collect ack holds back the next query.
+
+    int hostIndex = 0;           //!< Index in the host[] vector and of the cloud's inHost gate.
+    int firstOwnedCan = 0;       //!< Partition of the fleet this collector inspects every round.
+    int ownedCanCount = 0;
+    std::vector<int> workList;   //!< Inspection order: owned cans, then cans taken over from peers.
+    int assignedCans = 0;        //!< Entries of workList still assigned to this collector.
+
+    InspectionStrategy inspectionStrategy = InspectionStrategy::Serial;
+    int fanoutConcurrency = 0;  //!< Maximum cans inspected at once; 0 means unlimited.
+    size_t nextFanoutPosition = 0;  //!< First work list entry not yet launched in fan-out mode.
+    int activeInspections = 0;
+    int abandonedCans = 0;
+    simtime_t inspectionStartedAt;
+    simtime_t inspectionLatency = -1;  //!< Start to last can resolved in the latest complete round; negative until then.
+    simtime_t inspectionInterval;      //!< Period of inspection rounds; 0 inspects once.
+    long inspectionRounds = 0;
+
+    bool pushMode = false;             //!< Cans report state changes; polling only for silent cans.
+    simtime_t heartbeatTimeout;        //!< Push mode: poll a can not heard from for this long; 0 never polls.
+    cMessage *livenessEvent = nullptr;
+    long fallbackQueries = 0;          //!< Push mode: cans polled because their heartbeat was overdue.
+
+    bool workStealing = false;         //!< Report load to the cloud, which moves cans between collectors.
+    simtime_t loadReportInterval;      //!< Load report period while a round is running; 0 disables stealing.
+    cMessage *loadReportEvent = nullptr;
+    simtime_t busySince;               //!< Start of the current stretch with unresolved cans.
+    simtime_t busyTime;                //!< Total time spent with unresolved cans.
+    long cansInspected = 0;            //!< Status answers that resolved a can, over all rounds.
+    long queriesSent = 0;
+    long cansTakenOver = 0;
+    long cansHandedOver = 0;
 
     bool hostSendsCollect = true;
     bool expectCloudAck = true;
+    int collectWindow = 1;              //!< Collect requests allowed in flight at once.
+    simtime_t collectTimeout;           //!< Retransmit after this long without an ack; 0 disables.
+    int maxCollectRetransmissions = 3;
+    std::string snapshotFile;           //!< Empty unless the bookkeeping is saved.
+    cMessage *snapshotEvent = nullptr;
+    simtime_t cloudPausedUntil;         //!< The cloud asked for no new collects before this.
+    cMessage *cloudResumeEvent = nullptr;
     simtime_t retryInterval;
-    int maxQueryAttempts = 4;
+    int maxQueryAttempts = 4;           //!< Per-can attempt budget in both retry modes.
+    bool adaptiveRetry = false;         //!< Derive retry timeouts from measured RTTs instead of retryInterval.
+    simtime_t minRetryTimeout;
+    simtime_t maxRetryTimeout;
+    double retryJitter = 0;             //!< Relative +/- spread applied to each adaptive timeout.
+    long staleStatusResponses = 0;      //!< Replies to an attempt that had already been superseded.
     bool inspectionComplete = false;
 
+    int inCanBaseId = -1;
+    int inCloudGateId = -1;
+
     std::string communicationMode;
 
     long sentHostFast = 0;
@@ -157,51 +165,17 @@ class GarbageCollector : public cSimpleModule {
     long sentHostSlow = 0;
     long rcvdHostSlow = 0;
 
-    std::map<std::string, long> sentFastMessages;
-    std::map<std::string, long> receivedFastMessages;
-    std::map<std::string, long> sentSlowMessages;
-    std::map<std::string, long> receivedSlowMessages;
+    MessageCounterTable sentFastMessages;
+    MessageCounterTable receivedFastMessages;
+    MessageCounterTable sentSlowMessages;
+    MessageCounterTable receivedSlowMessages;
 
     cTextFigure *counterFigure = nullptr;
+    mutable bool countersDirty = false;  //!< Counters changed since the figure was last rendered.
 
     bool isValidCan(int canId) const
     {
-        return canId >= 0 && canId < kCanCount;
-    }
-
-    static void noteMessage(std::map<std::string, long> &bucket, const char *command)
-    {
-        const char *label = (command && *command) ? command : "<unknown>";
-        bucket[label]++;
-    }
-
-    static std::string describeMessages(const std::map<std::string, long> &bucket, const std::map<std::string, long> *counterpart = nullptr)
-    {
-        if (bucket.empty())
-            return "  none";
-
-        std::ostringstream oss;
-        for (auto it = bucket.begin(); it != bucket.end(); ++it) {
-            const std::string &command = it->first;
-            const long count = it->second;
-            long other = 0;
-            if (counterpart) {
-                auto found = counterpart->find(command);
-                if (found != counterpart->end())
-                    other = found->second;
-            }
-            const long diff = counterpart ? (count - other) : 0;
-            if (it != bucket.begin())
-                oss << "\n";
-            oss << "  " << command << " x" << count;
-            if (counterpart) {
-                if (other > 0)
-                    oss << " (matched " << other << ")";
-                if (diff > 0)
-                    oss << " (pending " << diff << ")";
-            }
-        }
-        return oss.str();
+        return canId >= 0 && canId < cans.size();
     }
 
     std::string formatStatusText() const
@@ -214,39 +188,42 @@ class GarbageCollector : public cSimpleModule {
         return oss.str();
     }
 
-    void updateHostCountersFigure()
+    /** Re-renders the counter figure; only called from refreshDisplay(). */
+    void updateHostCountersFigure() const
     {
-        if (!counterFigure)
+        if (!counterFigure || !countersDirty)
             return;
 
+        countersDirty = false;
         counterFigure->setVisible(true);
-        const std::string text = formatStatusText();
-        counterFigure->setText(text.c_str());
-        if (cModule *parent = getParentModule()) {
-            if (parent->hasPar("hostCountersText"))
-                parent->par("hostCountersText").setStringValue(text.c_str());
-        }
+        counterFigure->setText(formatStatusText().c_str());
     }
 
     /** Returns true when at least one collect request still waits for an ack. */
     bool hasPendingCollectAck() const
     {
-        return std::any_of(awaitingCollectAck.begin(), awaitingCollectAck.end(), [](bool awaiting) { return awaiting; });
+        return !inFlightCollects.empty();
+    }
+
+    /** True while another collect request may be sent without exceeding the window. */
+    bool collectWindowOpen() const
+    {
+        if (simTime() < cloudPausedUntil)
+            return false;
+        return !expectCloudAck || static_cast<int>(inFlightCollects.size()) < collectWindow;
     }
 
     /**
-     * Sends pending collect requests while respecting cloud-ack sequencing.
-     * When acknowledgements are expected, only one collect is in flight.
+     * Sends pending collect requests while respecting the in-flight window.
+     * When acknowledgements are expected, at most collectWindow collects are
+     * outstanding; without acks the whole queue is flushed at once.
      */
     void processCollectQueue()
     {
         if (!hostSendsCollect || !gate("outCloud")->isConnected())
             return;
 
-        if (hasPendingCollectAck())
-            return;
-
-        while (!collectQueue.empty()) {
+        while (!collectQueue.empty() && collectWindowOpen()) {
             int canId = collectQueue.front();
             collectQueue.pop_front();
 
@@ -256,9 +233,6 @@ class GarbageCollector : public cSimpleModule {
             }
 
             sendCollectRequest(canId);
-
-            if (expectCloudAck)
-                break;
         }
     }
 
@@ -270,54 +244,57 @@ class GarbageCollector : public cSimpleModule {
         if (!isValidCan(canId))
             return;
 
-        if (collectSent[canId])
+        if (cans.collectSent[canId])
             return;
 
-        collectSent[canId] = true;
+        cans.collectSent[canId] = 1;
         collectQueue.push_back(canId);
         processCollectQueue();
     }
 
 
-    void recordHostFastSend(const char *command)
+    void recordHostFastSend(const GarbagePacket *pkt)
     {
         ++sentHostFast;
-        noteMessage(sentFastMessages, command);
-        updateHostCountersFigure();
+        sentFastMessages.note(pkt);
+        countersDirty = true;
     }
 
-    void recordHostFastReceive(const char *command)
+    void recordHostFastReceive(const GarbagePacket *pkt)
     {
         ++rcvdHostFast;
-        noteMessage(receivedFastMessages, command);
-        updateHostCountersFigure();
+        receivedFastMessages.note(pkt);
+        countersDirty = true;
     }
 
-    void recordHostSlowSend(const char *command)
+    void recordHostSlowSend(const GarbagePacket *pkt)
     {
         ++sentHostSlow;
-        noteMessage(sentSlowMessages, command);
-        updateHostCountersFigure();
+        sentSlowMessages.note(pkt);
+        countersDirty = true;
     }
 
-    void recordHostSlowReceive(const char *command)
+    void recordHostSlowReceive(const GarbagePacket *pkt)
     {
         ++rcvdHostSlow;
-        noteMessage(receivedSlowMessages, command);
-        updateHostCountersFigure();
+        receivedSlowMessages.note(pkt);
+        countersDirty = true;
     }
 
-    /** Updates host counters based on the gate a packet arrived on. */
+    /**
+     * Updates host counters based on the gate a packet arrived on and emits
+     * the one-way latency since the sender stamped it.
+     */
     void recordArrivalCounters(GarbagePacket *pkt)
     {
         if (auto *arrivalGate = pkt->getArrivalGate()) {
-            const char *base = arrivalGate->getBaseName();
-            const char *command = pkt->getCommand();
-            if (strcmp(base, kInGateBaseNameFor(0)) == 0 || strcmp(base, kInGateBaseNameFor(1)) == 0) {
-                recordHostFastReceive(command);
+            if (arrivalGate->getBaseId() == inCanBaseId) {
+                recordHostFastReceive(pkt);
+                emit(canToHostLatencySignal, simTime() - pkt->getTimestamp(), pkt);
             }
-            else if (strcmp(base, "inCloud") == 0) {
-                recordHostSlowReceive(command);
+            else if (arrivalGate->getId() == inCloudGateId) {
+                recordHostSlowReceive(pkt);
+                emit(cloudToHostLatencySignal, simTime() - pkt->getTimestamp(), pkt);
             }
         }
     }
@@ -325,52 +302,225 @@ class GarbageCollector : public cSimpleModule {
     /** Cancels a scheduled retry event if one exists for the given can. */
     void cancelRetryIfScheduled(int canId)
     {
-        ensureRetryEvent(canId);
-        if (retryEvents[canId]->isScheduled())
-            cancelEvent(retryEvents[canId]);
+        if (CanTimer *timer = cans.retryEvents[canId])
+            cancelEvent(timer);
+    }
+
+    /** Sends a packet to the specified can over the fast channel and records metrics. */
+    void sendToCan(int canId, GarbagePacket *pkt)
+    {
+        recordHostFastSend(pkt);
+        pkt->setTimestamp();
+        send(pkt, "outCan", canId);
+    }
+
+    bool isFanout() const
+    {
+        return inspectionStrategy == InspectionStrategy::Fanout;
+    }
+
+    /** Launches queries for waiting cans until the fan-out concurrency limit is reached. */
+    void launchFanoutQueries()
+    {
+        while (nextFanoutPosition < workList.size()
+               && (fanoutConcurrency <= 0 || activeInspections < fanoutConcurrency)) {
+            const int canId = workList[nextFanoutPosition++];
+            if (!cans.assigned[canId])
+                continue;  // handed over to a peer before its turn
+            cans.inspecting[canId] = 1;
+            ++activeInspections;
+            scheduleQuery(canId, simTime());
+        }
+    }
+
+    /** Frees the fan-out slot held by a can that answered or was given up on. */
+    void releaseInspectionSlot(int canId)
+    {
+        if (!cans.inspecting[canId])
+            return;
+
+        cans.inspecting[canId] = 0;
+        --activeInspections;
+        launchFanoutQueries();
     }
 
-    /** Sends a fast-channel query to the specified can and records metrics. */
-    void sendQueryToCan(int canId, GarbagePacket *query)
+    /**
+     * Stops querying a can that never answered within maxQueryAttempts. In
+     * serial mode the walk moves on to the next can, as it would have after
+     * an answer.
+     */
+    void abandonCan(int canId)
     {
-        recordHostFastSend(query->getCommand());
-        send(query, kOutGateNameFor(canId));
+        if (cans.abandoned[canId])
+            return;
+
+        EV_WARN << "Reached max query attempts for can " << canId << " without response" << endl;
+        cans.abandoned[canId] = 1;
+        ++abandonedCans;
+        releaseInspectionSlot(canId);
+        if (!isFanout() && !pushMode)
+            maybeScheduleNextCanQuery(true, canId, false);
+        finalizeInspection();
+    }
+
+    /** A can given up on was heard from after all, or left the round. */
+    void clearAbandoned(int canId)
+    {
+        if (!cans.abandoned[canId])
+            return;
+        cans.abandoned[canId] = 0;
+        --abandonedCans;
     }
 
     /**
-     * Handles sequencing between the first and second can. When the first can
-     * is observed full, the collector may defer querying the second can until
-     * after the cloud acknowledges the triggered collect.
+     * Handles sequencing from one can to the next. When a can is observed
+     * full, the collector may defer querying the following can until after
+     * the cloud acknowledges the triggered collect.
      */
-    void maybeScheduleSecondCanQuery(bool firstObservation, int respondingCanId, bool reportedFull)
+    void maybeScheduleNextCanQuery(bool firstObservation, int respondingCanId, bool reportedFull)
     {
-        if (!firstObservation || respondingCanId != 0 || attemptCounters[1] != 0)
+        const int nextCanId = nextWorkCan(respondingCanId);
+        if (!firstObservation || nextCanId < 0 || cans.attempts[nextCanId] != 0)
             return;
 
-        const bool shouldDeferSecondQuery = reportedFull && hostSendsCollect && expectCloudAck
+        const bool shouldDeferNextQuery = reportedFull && hostSendsCollect && expectCloudAck
             && gate("outCloud")->isConnected();
-        if (shouldDeferSecondQuery) {
-            pendingSecondCanQuery = true;
+        if (shouldDeferNextQuery) {
+            deferringCan = respondingCanId;
         }
         else {
-            scheduleQuery(1, simTime() + retryInterval);
+            scheduleQuery(nextCanId, simTime() + retryInterval);
         }
     }
 
-    void ensureRetryEvent(int canId)
+    /** The can inspected after canId in serial mode, skipping cans handed over; -1 at the end. */
+    int nextWorkCan(int canId) const
     {
-        if (!retryEvents[canId]) {
-            std::ostringstream name;
-            name << "retry-can" << canId;
-            retryEvents[canId] = new cMessage(name.str().c_str());
+        if (cans.workIndex[canId] < 0)
+            return -1;
+        for (size_t pos = cans.workIndex[canId] + 1; pos < workList.size(); ++pos) {
+            if (cans.assigned[workList[pos]])
+                return workList[pos];
         }
+        return -1;
+    }
+
+    bool retryPending(int canId) const
+    {
+        return cans.retryEvents[canId] && cans.retryEvents[canId]->isScheduled();
+    }
+
+    /**
+     * Serial mode: starts the first waiting can when nothing is being queried
+     * any more, which happens when the can being queried was handed over or
+     * when cans taken over from a peer arrive after the round ended.
+     */
+    void resumeSerialInspection()
+    {
+        if (isFanout() || deferringCan >= 0)
+            return;
+
+        int firstWaiting = -1;
+        for (int canId : workList) {
+            if (!cans.assigned[canId] || cans.states[canId] != kUnknownState || cans.abandoned[canId])
+                continue;
+            if (cans.attempts[canId] > 0 || retryPending(canId))
+                return;  // the chain is still running
+            if (firstWaiting < 0)
+                firstWaiting = canId;
+        }
+        if (firstWaiting >= 0)
+            scheduleQuery(firstWaiting, simTime());
+    }
+
+    /** Makes the cans owned by this collector its whole work list again. */
+    void assignOwnedCans()
+    {
+        for (int canId : workList) {
+            cans.assigned[canId] = 0;
+            cans.takenOver[canId] = 0;
+            cans.workIndex[canId] = -1;
+        }
+        workList.clear();
+        for (int canId = firstOwnedCan; canId < firstOwnedCan + ownedCanCount; ++canId) {
+            cans.assigned[canId] = 1;
+            cans.workIndex[canId] = workList.size();
+            workList.push_back(canId);
+        }
+        assignedCans = ownedCanCount;
+    }
+
+    CanTimer *ensureRetryEvent(int canId)
+    {
+        CanTimer *&timer = cans.retryEvents[canId];
+        if (!timer) {
+            timer = new CanTimer("retry-can");
+            timer->setCanId(canId);
+        }
+        return timer;
     }
 
     void scheduleQuery(int canId, simtime_t when)
     {
-        ensureRetryEvent(canId);
-        cancelEvent(retryEvents[canId]);
-        scheduleAt(std::max(simTime(), when), retryEvents[canId]);
+        CanTimer *timer = ensureRetryEvent(canId);
+        cancelEvent(timer);
+        scheduleAt(std::max(simTime(), when), timer);
+    }
+
+    /**
+     * Delay before re-querying a can after its attempt-th query. In adaptive
+     * mode this is the can's RTO doubled per failed attempt, capped at
+     * maxRetryTimeout and spread by retryJitter so retries do not align.
+     */
+    simtime_t retryDelay(int canId, int attempt)
+    {
+        if (!adaptiveRetry)
+            return retryInterval;
+
+        const int doublings = std::min(attempt - 1, 16);
+        double timeout = std::ldexp(SIMTIME_DBL(cans.rto[canId]), doublings);
+        timeout = std::min(timeout, SIMTIME_DBL(maxRetryTimeout));
+        if (retryJitter > 0)
+            timeout *= uniform(1 - retryJitter, 1 + retryJitter);
+        return timeout;
+    }
+
+    /**
+     * Records one query round trip and, in adaptive mode, feeds it into the
+     * can's estimator (RFC 6298 gains). Only replies echoing the latest
+     * attempt are timed: an older attempt's reply cannot be matched to its
+     * send time, so it is skipped as in Karn's algorithm.
+     */
+    void sampleRoundTrip(GarbagePacket *pkt)
+    {
+        const int canId = pkt->getCanId();
+        const int echoedAttempt = pkt->getAttempt();
+        if (echoedAttempt > 0 && echoedAttempt < cans.attempts[canId])
+            ++staleStatusResponses;
+
+        if (echoedAttempt <= 0 || echoedAttempt != cans.attempts[canId])
+            return;
+
+        emit(queryRoundTripSignal, simTime() - cans.querySentAt[canId], pkt);
+        if (!adaptiveRetry)
+            return;
+
+        const double rtt = SIMTIME_DBL(simTime() - cans.querySentAt[canId]);
+        double &srtt = cans.srtt[canId];
+        double &rttvar = cans.rttvar[canId];
+        if (srtt < 0) {
+            srtt = rtt;
+            rttvar = rtt / 2;
+        }
+        else {
+            rttvar = 0.75 * rttvar + 0.25 * std::fabs(srtt - rtt);
+            srtt = 0.875 * srtt + 0.125 * rtt;
+        }
+
+        const simtime_t timeout = srtt + 4 * rttvar;
+        cans.rto[canId] = std::min(std::max(timeout, minRetryTimeout), maxRetryTimeout);
+        EV_DETAIL << "Can " << canId << " rtt=" << rtt << "s srtt=" << srtt
+                  << "s rttvar=" << rttvar << "s rto=" << cans.rto[canId] << "s" << endl;
     }
 
     /** Issues a status query for the given can, scheduling retries as needed. */
@@ -379,29 +529,87 @@ class GarbageCollector : public cSimpleModule {
         if (!isValidCan(canId))
             throw cRuntimeError("Invalid can id %d", canId);
 
-        if (canStates[canId] != kUnknownState)
+        if (cans.states[canId] != kUnknownState)
             return;
 
-        const int currentAttempt = ++attemptCounters[canId];
-        if (currentAttempt > maxQueryAttempts) {
-            EV_WARN << "Reached max query attempts for can " << canId << " without response" << endl;
+        if (cans.attempts[canId] >= maxQueryAttempts) {
+            abandonCan(canId);
             return;
         }
+        const int currentAttempt = ++cans.attempts[canId];
 
         auto *query = new GarbagePacket("Is the can full?");
-        query->setCommand(kQueryCommandFor(canId));
+        query->setOpcode(OP_QUERY);
         query->setCanId(canId);
         query->setIsFull(false);
         query->setTravelTime(0);
         const std::string attemptNote = "attempt=" + std::to_string(currentAttempt);
         query->setNote(attemptNote.c_str());
+        query->setAttempt(currentAttempt);
 
-        sendQueryToCan(canId, query);
+        cans.querySentAt[canId] = simTime();
+        sendToCan(canId, query);
+        ++queriesSent;
 
         EV_INFO << "Sent query attempt " << currentAttempt << " to can " << canId << endl;
 
-        if (canStates[canId] == kUnknownState && currentAttempt < maxQueryAttempts)
-            scheduleQuery(canId, simTime() + retryInterval);
+        // One extra timer past the last attempt abandons an unanswered can, so
+        // it gives its fan-out slot back or lets the serial walk move on.
+        scheduleQuery(canId, simTime() + retryDelay(canId, currentAttempt));
+    }
+
+    /**
+     * Forgets what the previous round learned about the cans so they are all
+     * queried again. Collects still queued or awaiting an ack stay marked, so
+     * a can is not collected twice; RTT estimates carry over.
+     */
+    void resetInspectionRound()
+    {
+        if (!inspectionComplete)
+            EV_WARN << "Starting inspection round " << inspectionRounds + 1 << " before round "
+                    << inspectionRounds << " resolved every can" << endl;
+
+        std::vector<uint8_t> queued(cans.size(), 0);
+        for (int canId : collectQueue)
+            queued[canId] = 1;
+
+        for (int canId : workList) {
+            cancelRetryIfScheduled(canId);
+            cans.states[canId] = kUnknownState;
+            cans.attempts[canId] = 0;
+            cans.inspecting[canId] = 0;
+            cans.abandoned[canId] = 0;
+            if (!queued[canId] && !cans.awaitingCollectAck[canId])
+                cans.collectSent[canId] = 0;
+        }
+        assignOwnedCans();
+        knownCans = 0;
+        abandonedCans = 0;
+        activeInspections = 0;
+        nextFanoutPosition = 0;
+        deferringCan = -1;
+        inspectionComplete = false;
+    }
+
+    void startInspectionRound()
+    {
+        if (inspectionRounds > 0)
+            resetInspectionRound();
+        ++inspectionRounds;
+
+        EV_INFO << "Collector starting inspection round " << inspectionRounds << " (mode=" << communicationMode
+                << ", hostSendsCollect=" << (hostSendsCollect ? "true" : "false")
+                << ", strategy=" << par("inspectionStrategy").stdstringValue()
+                << ")" << endl;
+        inspectionStartedAt = simTime();
+        busySince = simTime();
+        if (isFanout())
+            launchFanoutQueries();
+        else if (!workList.empty())
+            scheduleQuery(workList.front(), simTime());
+        if (workStealing && !loadReportEvent->isScheduled())
+            scheduleAfter(loadReportInterval, loadReportEvent);
+        finalizeInspection();  // a collector without cans is done at once
     }
 
     /** Processes a status response from one of the cans. */
@@ -413,87 +621,455 @@ class GarbageCollector : public cSimpleModule {
             return;
         }
 
+        cans.lastHeard[canId] = simTime();
+        if (cans.attempts[canId] == 0 || !cans.assigned[canId]) {
+            // Answer to a query of an earlier round, or of a can handed over since.
+            ++staleStatusResponses;
+            return;
+        }
+
+        sampleRoundTrip(pkt);
+
         const bool isFull = pkt->isFull();
-        const bool firstObservation = (canStates[canId] == kUnknownState);
-        canStates[canId] = isFull ? 1 : 0;
+        const bool firstObservation = (cans.states[canId] == kUnknownState);
+        if (firstObservation) {
+            ++knownCans;
+            ++cansInspected;
+        }
+        cans.states[canId] = isFull ? 1 : 0;
+        clearAbandoned(canId);
 
         EV_INFO << "Can " << canId << " reported " << (isFull ? "full" : "empty")
-                << " after " << attemptCounters[canId] << " attempts" << endl;
+                << " after " << cans.attempts[canId] << " attempts" << endl;
 
         cancelRetryIfScheduled(canId);
 
         if (isFull && hostSendsCollect && gate("outCloud")->isConnected())
             enqueueCollect(canId);
 
-        maybeScheduleSecondCanQuery(firstObservation, canId, isFull);
+        if (isFanout())
+            releaseInspectionSlot(canId);
+        else if (!pushMode)
+            maybeScheduleNextCanQuery(firstObservation, canId, isFull);
+
+        finalizeInspection();
+    }
+
+    /**
+     * Applies a fill state reported by a push notification or heartbeat. An
+     * empty report clears the collect marker, so the can's next fill is
+     * collected again.
+     */
+    void applyReportedState(int canId, bool isFull)
+    {
+        if (cans.states[canId] == kUnknownState)
+            ++knownCans;
+        clearAbandoned(canId);
+        cans.states[canId] = isFull ? 1 : 0;
+        cancelRetryIfScheduled(canId);
 
+        if (isFull) {
+            if (hostSendsCollect && gate("outCloud")->isConnected())
+                enqueueCollect(canId);
+        }
+        else if (!cans.awaitingCollectAck[canId]
+                 && std::find(collectQueue.begin(), collectQueue.end(), canId) == collectQueue.end()) {
+            cans.collectSent[canId] = 0;
+        }
         finalizeInspection();
     }
 
-    bool allCansKnown() const
+    /** Acks a push notification and applies it unless a newer one was already applied. */
+    void handleNotification(GarbagePacket *pkt)
+    {
+        const int canId = pkt->getCanId();
+        if (!isValidCan(canId)) {
+            EV_WARN << "Received notification from unknown can " << canId << endl;
+            return;
+        }
+
+        auto *ack = new GarbagePacket("notify-ack");
+        ack->setOpcode(OP_NOTIFY_ACK);
+        ack->setCanId(canId);
+        ack->setRequestId(pkt->getRequestId());
+        sendToCan(canId, ack);
+
+        cans.lastHeard[canId] = simTime();
+        if (pkt->getRequestId() <= cans.lastNotifySeq[canId])
+            return;
+        cans.lastNotifySeq[canId] = pkt->getRequestId();
+        EV_INFO << "Can " << canId << " notified that it is " << (pkt->isFull() ? "full" : "empty") << endl;
+        applyReportedState(canId, pkt->isFull());
+    }
+
+    /** A heartbeat also repairs a state change whose notification was given up on. */
+    void handleHeartbeat(GarbagePacket *pkt)
+    {
+        const int canId = pkt->getCanId();
+        if (!isValidCan(canId))
+            return;
+
+        cans.lastHeard[canId] = simTime();
+        const int8_t reported = pkt->isFull() ? 1 : 0;
+        if (cans.states[canId] != reported)
+            applyReportedState(canId, pkt->isFull());
+    }
+
+    /** Push mode: polls every can that has been silent for longer than heartbeatTimeout. */
+    void checkLiveness()
     {
-        return std::find(canStates.begin(), canStates.end(), kUnknownState) == canStates.end();
+        const simtime_t now = simTime();
+        for (int canId : workList) {
+            if (now - cans.lastHeard[canId] <= heartbeatTimeout)
+                continue;
+            if (cans.retryEvents[canId] && cans.retryEvents[canId]->isScheduled())
+                continue;  // already being polled
+
+            EV_INFO << "No heartbeat from can " << canId << " for " << now - cans.lastHeard[canId] << "s, querying it" << endl;
+            ++fallbackQueries;
+            if (cans.states[canId] != kUnknownState)
+                --knownCans;
+            cans.states[canId] = kUnknownState;
+            cans.attempts[canId] = 0;
+            clearAbandoned(canId);
+            scheduleQuery(canId, now);
+        }
+        scheduleAfter(heartbeatTimeout, livenessEvent);
+    }
+
+    /** True once every can has either reported or been given up on. */
+    bool allCansResolved() const
+    {
+        return knownCans + abandonedCans >= assignedCans;
     }
 
-    /** Marks the inspection finished once both cans have reported. */
+    /** Marks the inspection finished once every can has been resolved. */
     void finalizeInspection()
     {
-        if (inspectionComplete || !allCansKnown())
+        if (inspectionComplete || !allCansResolved())
             return;
 
         inspectionComplete = true;
+        inspectionLatency = simTime() - inspectionStartedAt;
+        busyTime += simTime() - busySince;
 
-        EV_INFO << "Inspection complete: can0="
-                << (canStates[0] == 1 ? "full" : "empty")
-                << ", can1=" << (canStates[1] == 1 ? "full" : "empty") << endl;
+        const auto fullCans = std::count_if(workList.begin(), workList.end(),
+            [this](int canId) { return cans.assigned[canId] && cans.states[canId] == 1; });
+        EV_INFO << "Inspection complete after " << inspectionLatency << "s: " << fullCans
+                << " of " << assignedCans << " cans full, " << abandonedCans << " unanswered" << endl;
+
+        if (workStealing)
+            sendLoadReport();  // idle: ask for a share of a busy peer's cans
 
         if (!hostSendsCollect || !gate("outCloud")->isConnected())
             return;
 
-        for (int canId = 0; canId < kCanCount; ++canId) {
-            if (canStates[canId] == 1)
+        for (int canId : workList) {
+            if (cans.assigned[canId] && cans.states[canId] == 1)
                 enqueueCollect(canId);
         }
     }
 
-    /** Sends a collect request for the provided can over the slow cloud link. */
-    void sendCollectRequest(int canId)
+    /**
+     * Cans a peer may take over: unresolved, not taken over already, and
+     * either unanswered, not yet queried, or retried at least once. A can in
+     * its first query attempt is kept, since its answer is probably on the way.
+     */
+    bool isStealable(int canId) const
     {
-        collectSent[canId] = true;
+        if (!cans.assigned[canId] || cans.takenOver[canId] || cans.states[canId] != kUnknownState)
+            return false;
+        if (cans.abandoned[canId])
+            return true;
+        return cans.attempts[canId] == 0 ? !retryPending(canId) : cans.attempts[canId] >= 2;
+    }
+
+    int stealableCount() const
+    {
+        return std::count_if(workList.begin(), workList.end(), [this](int canId) { return isStealable(canId); });
+    }
 
+    void sendToCloud(GarbagePacket *pkt)
+    {
+        pkt->setTimestamp();
+        recordHostSlowSend(pkt);
+        send(pkt, "outCloud");
+    }
+
+    void sendLoadReport()
+    {
+        auto *report = new WorkSteal("load-report");
+        report->setOpcode(OP_LOAD_REPORT);
+        report->setHostIndex(hostIndex);
+        report->setBacklog(stealableCount());
+        report->setIdle(inspectionComplete);
+        sendToCloud(report);
+    }
+
+    /**
+     * Hands up to the ordered number of cans to an idle peer: unanswered cans
+     * first, then those not queried yet from the end of the work list, then
+     * overdue ones. The grant travels back through the cloud.
+     */
+    void handleStealOrder(WorkSteal *order)
+    {
+        const int limit = order->getBacklog();
+        std::vector<int> handed;
+        auto pick = [&](int canId) {
+            if (int(handed.size()) < limit && isStealable(canId)
+                && std::find(handed.begin(), handed.end(), canId) == handed.end())
+                handed.push_back(canId);
+        };
+        for (int canId : workList) {
+            if (cans.abandoned[canId])
+                pick(canId);
+        }
+        for (auto it = workList.rbegin(); it != workList.rend(); ++it) {
+            if (cans.attempts[*it] == 0)
+                pick(*it);
+        }
+        for (int canId : workList)
+            pick(canId);
+
+        for (int canId : handed) {
+            cancelRetryIfScheduled(canId);
+            cans.assigned[canId] = 0;
+            --assignedCans;
+            clearAbandoned(canId);
+            if (cans.inspecting[canId]) {
+                cans.inspecting[canId] = 0;
+                --activeInspections;
+            }
+        }
+        cansHandedOver += handed.size();
+
+        auto *grant = new WorkSteal("steal-grant");
+        grant->setOpcode(OP_STEAL_GRANT);
+        grant->setHostIndex(order->getHostIndex());
+        grant->setCanIdsArraySize(handed.size());
+        for (size_t k = 0; k < handed.size(); ++k)
+            grant->setCanIds(k, handed[k]);
+        grant->setBacklog(stealableCount());
+        grant->setIdle(inspectionComplete || allCansResolved());
+        sendToCloud(grant);
+        EV_INFO << "Handed " << handed.size() << " cans over to collector " << order->getHostIndex() << endl;
+
+        if (isFanout())
+            launchFanoutQueries();
+        else
+            resumeSerialInspection();
+        finalizeInspection();
+    }
+
+    /** Adds the cans a peer handed over to this collector's round. */
+    void handleStealGrant(WorkSteal *grant)
+    {
+        int added = 0;
+        for (size_t k = 0; k < grant->getCanIdsArraySize(); ++k) {
+            const int canId = grant->getCanIds(k);
+            if (!isValidCan(canId) || cans.assigned[canId])
+                continue;
+            cancelRetryIfScheduled(canId);
+            cans.assigned[canId] = 1;
+            cans.takenOver[canId] = 1;
+            cans.states[canId] = kUnknownState;
+            cans.attempts[canId] = 0;
+            clearAbandoned(canId);
+            cans.workIndex[canId] = workList.size();
+            workList.push_back(canId);
+            ++assignedCans;
+            ++added;
+        }
+        if (added == 0)
+            return;
+
+        cansTakenOver += added;
+        EV_INFO << "Took over " << added << " cans from collector " << grant->getHostIndex() << endl;
+        if (inspectionComplete) {
+            inspectionComplete = false;
+            busySince = simTime();
+        }
+        if (workStealing && !loadReportEvent->isScheduled())
+            scheduleAfter(loadReportInterval, loadReportEvent);
+        if (isFanout())
+            launchFanoutQueries();
+        else
+            resumeSerialInspection();
+    }
+
+    /** Puts one transmission of a collect request on the slow cloud link. */
+    void transmitCollect(long requestId, int canId, int transmission)
+    {
         auto *collect = new GarbagePacket("Collect garbage");
-        collect->setCommand(kCollectCommandFor(canId));
+        collect->setOpcode(OP_COLLECT);
         collect->setCanId(canId);
         collect->setIsFull(true);
         collect->setTravelTime(0);
         collect->setNote(communicationMode.c_str());
-        recordHostSlowSend(collect->getCommand());
-        send(collect, "outCloud");
-        incrementParentCounter(this, "hostCollectCount");
-        EV_INFO << "Sent collect request for can " << canId << " to the cloud" << endl;
+        collect->setRequestId(requestId);
+        sendToCloud(collect);
+        emit(collectSentSignal, canId);
+        EV_INFO << "Sent collect request " << requestId << " for can " << canId
+                << " to the cloud (transmission " << transmission << ")" << endl;
+    }
+
+    /** Sends a collect request for the provided can over the slow cloud link. */
+    void sendCollectRequest(int canId)
+    {
+        cans.collectSent[canId] = 1;
+
+        const long requestId = nextCollectRequestId++;
+        transmitCollect(requestId, canId, 1);
 
-        if (expectCloudAck)
-            awaitingCollectAck[canId] = true;
+        if (!expectCloudAck || cans.awaitingCollectAck[canId])
+            return;
+
+        cans.awaitingCollectAck[canId] = 1;
+        InFlightCollect &entry = inFlightCollects[requestId];
+        entry.canId = canId;
+        entry.transmissions = 1;
+        entry.firstSentAt = simTime();
+        if (collectTimeout > SIMTIME_ZERO) {
+            entry.timeout = new CollectTimer("collect-timeout");
+            entry.timeout->setRequestId(requestId);
+            scheduleAfter(collectTimeout, entry.timeout);
+        }
     }
 
-    /** Handles acknowledgements from the cloud for previously sent collects. */
-    void handleCloudAck(GarbagePacket *pkt)
+    /** Retransmits an unacknowledged collect, or gives up once the budget is spent. */
+    void handleCollectTimeout(CollectTimer *timer)
     {
-        const int canId = pkt->getCanId();
-        if (!isValidCan(canId)) {
-            EV_WARN << "Cloud acknowledgement missing can id" << endl;
+        auto it = inFlightCollects.find(timer->getRequestId());
+        if (it == inFlightCollects.end() || it->second.timeout != timer)
+            throw cRuntimeError("Collect timer fired for unknown request %ld", timer->getRequestId());
+
+        InFlightCollect &entry = it->second;
+        if (entry.transmissions > maxCollectRetransmissions) {
+            EV_WARN << "Giving up on collect request " << it->first << " for can " << entry.canId
+                    << " after " << entry.transmissions << " transmissions" << endl;
+            const int canId = entry.canId;
+            delete entry.timeout;
+            inFlightCollects.erase(it);
+            completeCollect(canId);
             return;
         }
 
-        awaitingCollectAck[canId] = false;
-        EV_INFO << "Cloud acknowledgement received for can " << canId
-                << ": " << (pkt->getNote() ? pkt->getNote() : "") << endl;
-        incrementParentCounter(this, "hostCollectAckCount");
+        ++entry.transmissions;
+        transmitCollect(it->first, entry.canId, entry.transmissions);
+        scheduleAfter(collectTimeout, timer);
+    }
+
+    /**
+     * Releases the window slot of a finished collect (acked or given up) and
+     * resumes anything that was waiting on it.
+     */
+    void completeCollect(int canId)
+    {
+        cans.awaitingCollectAck[canId] = 0;
         processCollectQueue();
 
-        if (pendingSecondCanQuery && canId == 0 && attemptCounters[1] == 0) {
-            pendingSecondCanQuery = false;
-            scheduleQuery(1, simTime() + retryInterval);
+        if (deferringCan == canId) {
+            deferringCan = -1;
+            const int nextCanId = nextWorkCan(canId);
+            if (nextCanId >= 0 && cans.attempts[nextCanId] == 0)
+                scheduleQuery(nextCanId, simTime() + retryInterval);
+        }
+    }
+
+    /** Handles acknowledgements from the cloud, matched to the request they answer. */
+    void handleCloudAck(GarbagePacket *pkt)
+    {
+        auto it = inFlightCollects.find(pkt->getRequestId());
+        if (it == inFlightCollects.end()) {
+            EV_INFO << "Ignoring duplicate or unsolicited cloud acknowledgement for request "
+                    << pkt->getRequestId() << " (can " << pkt->getCanId() << ")" << endl;
+            return;
+        }
+
+        const int canId = it->second.canId;
+        if (it->second.transmissions == 1)
+            emit(collectRoundTripSignal, simTime() - it->second.firstSentAt, pkt);
+        cancelAndDelete(it->second.timeout);
+        inFlightCollects.erase(it);
+
+        EV_INFO << "Cloud acknowledgement received for request " << pkt->getRequestId()
+                << " (can " << canId << "): " << (pkt->getNote() ? pkt->getNote() : "") << endl;
+        emit(collectAckedSignal, canId);
+        completeCollect(canId);
+    }
+
+    /** Holds new collects back for the cloud's retry hint. */
+    void pauseCloud(simtime_t hint)
+    {
+        if (simTime() + hint <= cloudPausedUntil)
+            return;
+        cloudPausedUntil = simTime() + hint;
+        cancelEvent(cloudResumeEvent);
+        scheduleAt(cloudPausedUntil, cloudResumeEvent);
+    }
+
+    /**
+     * The cloud's queue was full. A rejected collect gives up its window slot
+     * and goes back to the front of the queue, to be sent again under a new
+     * request id once the retry hint has passed.
+     */
+    void handleCloudBusy(GarbagePacket *pkt)
+    {
+        pauseCloud(pkt->getTravelTime());
+        const auto *rejected = dynamic_cast<const GarbagePacket *>(pkt->getEncapsulatedPacket());
+        if (!rejected || rejected->getOpcode() != OP_COLLECT || !isValidCan(rejected->getCanId()))
+            return;
+
+        const int canId = rejected->getCanId();
+        if (expectCloudAck) {
+            auto it = inFlightCollects.find(rejected->getRequestId());
+            if (it == inFlightCollects.end())
+                return;  // an earlier transmission got through
+            cancelAndDelete(it->second.timeout);
+            inFlightCollects.erase(it);
+            cans.awaitingCollectAck[canId] = 0;
+        }
+        collectQueue.push_front(canId);
+        EV_INFO << "Cloud turned collect request " << rejected->getRequestId() << " for can " << canId
+                << " away, retrying in " << pkt->getTravelTime() << "s" << endl;
+    }
+
+    void takeSnapshot()
+    {
+        FleetSnapshot &snapshot = FleetSnapshot::open(snapshotFile, cans.size(), FleetSnapshot::Mode::Write);
+        snapshot.stamp(SIMTIME_DBL(simTime()));
+        for (int canId = firstOwnedCan; canId < firstOwnedCan + ownedCanCount; ++canId) {
+            FleetSnapshot::CollectorRecord record = {};
+            record.srtt = cans.srtt[canId];
+            record.rttvar = cans.rttvar[canId];
+            record.rto = SIMTIME_DBL(cans.rto[canId]);
+            record.lastNotifySeq = cans.lastNotifySeq[canId];
+            record.state = cans.states[canId];
+            snapshot.putCollector(canId, record);
+        }
+    }
+
+    /**
+     * Loads the owned cans' entries of a snapshot. The retry estimators are
+     * always restored; fill states and notification numbers only in push
+     * mode, since poll mode forgets them at every round.
+     */
+    void warmStart(const FleetSnapshot &snapshot)
+    {
+        for (int canId = firstOwnedCan; canId < firstOwnedCan + ownedCanCount; ++canId) {
+            const FleetSnapshot::CollectorRecord *record = snapshot.findCollector(canId);
+            if (!record)
+                continue;
+            cans.srtt[canId] = record->srtt;
+            cans.rttvar[canId] = record->rttvar;
+            cans.rto[canId] = record->rto;
+            if (!pushMode)
+                continue;
+            cans.lastNotifySeq[canId] = record->lastNotifySeq;
+            if (record->state != kUnknownState) {
+                cans.states[canId] = record->state;
+                ++knownCans;
+            }
         }
     }
 
@@ -503,8 +1079,67 @@ class GarbageCollector : public cSimpleModule {
         communicationMode = par("communicationMode").stdstringValue();
         retryInterval = par("queryRetryInterval");
         maxQueryAttempts = par("maxQueryAttempts");
+        inspectionInterval = par("inspectionInterval");
+        adaptiveRetry = par("adaptiveRetry");
+        minRetryTimeout = par("minRetryTimeout");
+        maxRetryTimeout = par("maxRetryTimeout");
+        retryJitter = par("retryJitter");
+        if (minRetryTimeout > maxRetryTimeout)
+            throw cRuntimeError("minRetryTimeout (%s) exceeds maxRetryTimeout (%s)",
+                minRetryTimeout.str().c_str(), maxRetryTimeout.str().c_str());
+        if (retryJitter < 0 || retryJitter >= 1)
+            throw cRuntimeError("retryJitter must be in [0, 1), got %g", retryJitter);
         hostSendsCollect = par("hostSendsCollect");
         expectCloudAck = par("expectCloudAck");
+        collectWindow = par("collectWindow");
+        collectTimeout = par("collectTimeout");
+        maxCollectRetransmissions = par("maxCollectRetransmissions");
+        if (collectWindow < 1)
+            throw cRuntimeError("collectWindow must be at least 1, got %d", collectWindow);
+        fanoutConcurrency = par("fanoutConcurrency");
+
+        const std::string reportingMode = par("reportingMode").stdstringValue();
+        pushMode = reportingMode == "push";
+        if (!pushMode && reportingMode != "poll")
+            throw cRuntimeError("Unknown reportingMode '%s' (expected \"poll\" or \"push\")", reportingMode.c_str());
+        heartbeatTimeout = par("heartbeatTimeout");
+
+        const std::string strategy = par("inspectionStrategy").stdstringValue();
+        if (strategy == "serial")
+            inspectionStrategy = InspectionStrategy::Serial;
+        else if (strategy == "fanout")
+            inspectionStrategy = InspectionStrategy::Fanout;
+        else
+            throw cRuntimeError("Unknown inspectionStrategy '%s' (expected \"serial\" or \"fanout\")", strategy.c_str());
+
+        const int numCans = gateSize("outCan");
+        if (numCans != gateSize("inCan"))
+            throw cRuntimeError("Gate vectors inCan[%d] and outCan[%d] differ in size", gateSize("inCan"), numCans);
+        cans.resize(numCans, kUnknownState, retryInterval);
+
+        hostIndex = getIndex();
+        firstOwnedCan = par("firstOwnedCan");
+        ownedCanCount = par("ownedCans");
+        if (ownedCanCount < 0)
+            ownedCanCount = numCans - firstOwnedCan;
+        if (ownedCanCount == 0 && numCans > 0)
+            throw cRuntimeError("Collector %d owns no cans: numHosts must not exceed numCans (%d)", hostIndex, numCans);
+        if (firstOwnedCan < 0 || ownedCanCount < 0 || firstOwnedCan + ownedCanCount > numCans)
+            throw cRuntimeError("Owned cans [%d, %d) exceed the fleet of %d cans",
+                firstOwnedCan, firstOwnedCan + ownedCanCount, numCans);
+        assignOwnedCans();
+        const std::string warmStartFile = par("warmStartFile").stdstringValue();
+        if (!warmStartFile.empty())
+            warmStart(FleetSnapshot::open(warmStartFile, numCans, FleetSnapshot::Mode::Read));
+        snapshotFile = par("snapshotFile").stdstringValue();
+        const simtime_t snapshotAt = par("snapshotAt");
+        if (!snapshotFile.empty() && snapshotAt >= SIMTIME_ZERO) {
+            snapshotEvent = new cMessage("snapshot");
+            scheduleAt(snapshotAt, snapshotEvent);
+        }
+
+        inCanBaseId = gateBaseId("inCan");
+        inCloudGateId = gate("inCloud")->getId();
 
         if (communicationMode == "GarbageInTheCansAndSlow") {
             hostSendsCollect = true;
@@ -523,8 +1158,26 @@ class GarbageCollector : public cSimpleModule {
             }
         }
 
-        counterFigure = requireTextFigure(this, "hostCounters");
-        updateHostCountersFigure();
+        // The canvas has a single collector counter figure; host[0] owns it.
+        counterFigure = hostIndex == 0 ? findTextFigure(this, "hostCounters") : nullptr;
+        countersDirty = true;
+
+        loadReportInterval = par("loadReportInterval");
+        workStealing = !pushMode && loadReportInterval > SIMTIME_ZERO && gate("outCloud")->isConnected();
+        cloudResumeEvent = new cMessage("cloudResume");
+        if (workStealing)
+            loadReportEvent = new cMessage("loadReport");
+
+        if (pushMode) {
+            // Cans report on their own; nothing is polled until a can falls silent.
+            nextFanoutPosition = workList.size();
+            inspectionStartedAt = simTime();
+            if (heartbeatTimeout > SIMTIME_ZERO) {
+                livenessEvent = new cMessage("liveness");
+                scheduleAfter(heartbeatTimeout, livenessEvent);
+            }
+            return;
+        }
 
         startEvent = new cMessage("startEvent");
         scheduleAt(simTime(), startEvent);
@@ -533,64 +1186,141 @@ class GarbageCollector : public cSimpleModule {
     void handleMessage(cMessage *msg) override
     {
         if (msg == startEvent) {
-            EV_INFO << "Collector starting inspection (mode=" << communicationMode
-                    << ", hostSendsCollect=" << (hostSendsCollect ? "true" : "false")
-                    << ")" << endl;
-            scheduleQuery(0, simTime());
+            startInspectionRound();
+            if (inspectionInterval > SIMTIME_ZERO)
+                scheduleAfter(inspectionInterval, startEvent);
             return;
         }
 
-        for (int canId = 0; canId < kCanCount; ++canId) {
-            if (msg == retryEvents[canId]) {
-                attemptQuery(canId);
-                return;
+        if (msg == livenessEvent) {
+            checkLiveness();
+            return;
+        }
+
+        if (msg == loadReportEvent) {
+            if (!inspectionComplete) {
+                sendLoadReport();
+                scheduleAfter(loadReportInterval, loadReportEvent);
             }
+            return;
+        }
+
+        if (msg == snapshotEvent) {
+            takeSnapshot();
+            return;
+        }
+
+        if (msg == cloudResumeEvent) {
+            processCollectQueue();
+            return;
+        }
+
+        if (auto *timer = dynamic_cast<CanTimer *>(msg)) {
+            attemptQuery(timer->getCanId());
+            return;
+        }
+
+        if (auto *timer = dynamic_cast<CollectTimer *>(msg)) {
+            handleCollectTimeout(timer);
+            return;
         }
 
         auto *pkt = check_and_cast<GarbagePacket *>(msg);
-        const std::string command = pkt->getCommand();
         recordArrivalCounters(pkt);
 
-        if (isStatusCommand(command)) {
-            handleStatus(pkt);
-        }
-        else {
-            int ackCanId = -1;
-            if (isCollectAckCommand(command, ackCanId)) {
+        switch (pkt->getOpcode()) {
+            case OP_STATUS_NO:
+            case OP_STATUS_YES:
+                handleStatus(pkt);
+                break;
+            case OP_COLLECT_ACK:
                 handleCloudAck(pkt);
-            }
-            else {
-                EV_WARN << "Collector received unexpected command '" << command << "'" << endl;
-            }
+                break;
+            case OP_NOTIFY:
+                handleNotification(pkt);
+                break;
+            case OP_HEARTBEAT:
+                handleHeartbeat(pkt);
+                break;
+            case OP_STEAL_ORDER:
+                handleStealOrder(check_and_cast<WorkSteal *>(pkt));
+                break;
+            case OP_STEAL_GRANT:
+                handleStealGrant(check_and_cast<WorkSteal *>(pkt));
+                break;
+            case OP_CLOUD_BUSY:
+                handleCloudBusy(pkt);
+                break;
+            case OP_BACKPRESSURE:
+                pauseCloud(pkt->getTravelTime());
+                break;
+            default:
+                EV_WARN << "Collector received unexpected command '" << commandLabel(pkt) << "'" << endl;
+                break;
         }
         delete pkt;
     }
 
     void finish() override
     {
-        for (bool awaiting : awaitingCollectAck) {
-            if (awaiting)
-                EV_WARN << "Collector finished without receiving all cloud acknowledgements" << endl;
+        if (!snapshotFile.empty() && !snapshotEvent)
+            takeSnapshot();  // no snapshotAt: the state at the end of the run
+
+        if (hasPendingCollectAck())
+            EV_WARN << "Collector finished without receiving all cloud acknowledgements" << endl;
+
+        // One sample per can, so the histogram shows how the query budget was spent.
+        for (int canId : workList)
+            emit(queryAttemptsSignal, cans.attempts[canId]);
+
+        if (inspectionLatency >= SIMTIME_ZERO)
+            recordScalar("inspectionLatency", inspectionLatency);
+        else
+            EV_WARN << "Collector finished before every can was inspected" << endl;
+        recordScalar("inspectionRounds", inspectionRounds);
+        recordScalar("inspectionUnansweredCans", abandonedCans);
+        recordScalar("staleStatusResponses", staleStatusResponses);
+        if (pushMode)
+            recordScalar("fallbackQueries", fallbackQueries);
+
+        // Load balance between collectors: how much of the work this one did.
+        recordScalar("ownedCans", ownedCanCount);
+        recordScalar("cansInspected", cansInspected);
+        recordScalar("queriesSent", queriesSent);
+        recordScalar("busyTime", busyTime + (inspectionComplete ? SIMTIME_ZERO : simTime() - busySince));
+        if (workStealing) {
+            recordScalar("cansTakenOver", cansTakenOver);
+            recordScalar("cansHandedOver", cansHandedOver);
         }
 
-        setParentIntParameter(this, "hostCan0Attempts", attemptCounters[0]);
-        setParentIntParameter(this, "hostCan1Attempts", attemptCounters[1]);
+        // Collector link load per can, comparable between poll and push mode.
+        const double canHours = ownedCanCount * SIMTIME_DBL(simTime()) / 3600;
+        if (canHours > 0) {
+            recordScalar("canMessagesPerCanHour", (sentHostFast + rcvdHostFast) / canHours);
+            recordScalar("cloudMessagesPerCanHour", (sentHostSlow + rcvdHostSlow) / canHours);
+        }
     }
 
     void refreshDisplay() const override
     {
-        const_cast<GarbageCollector *>(this)->updateHostCountersFigure();
+        updateHostCountersFigure();
     }
 
     ~GarbageCollector() override
     {
         cancelAndDelete(startEvent);
-        for (auto &evt : retryEvents) {
+        cancelAndDelete(livenessEvent);
+        cancelAndDelete(loadReportEvent);
+        cancelAndDelete(cloudResumeEvent);
+        cancelAndDelete(snapshotEvent);
+        for (auto &evt : cans.retryEvents) {
             if (evt) {
                 cancelAndDelete(evt);
                 evt = nullptr;
             }
         }
+        for (auto &entry : inFlightCollects)
+            cancelAndDelete(entry.second.timeout);
     }
 };
 
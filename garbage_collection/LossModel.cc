@@ -0,0 +1,95 @@
+#include "LossModel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+
+using namespace omnetpp;
+
+namespace garbage_collection {
+
+namespace {
+
+void requireProbability(const char *name, double value)
+{
+    if (value < 0 || value > 1)
+        throw cRuntimeError("%s must be a probability in [0, 1], got %g", name, value);
+}
+
+} // namespace
+
+bool DeterministicLoss::dropNext()
+{
+    if (remaining <= 0)
+        return false;
+    --remaining;
+    return true;
+}
+
+BernoulliLoss::BernoulliLoss(cRNG *rng, double probability)
+    : rng(rng), probability(probability)
+{
+    requireProbability("lossProbability", probability);
+}
+
+bool BernoulliLoss::dropNext()
+{
+    return probability > 0 && rng->doubleRand() < probability;
+}
+
+GilbertElliottLoss::GilbertElliottLoss(cRNG *rng, double goodToBad, double badToGood, double lossGood, double lossBad)
+    : rng(rng), goodToBad(goodToBad), badToGood(badToGood), lossGood(lossGood), lossBad(lossBad)
+{
+    requireProbability("geGoodToBad", goodToBad);
+    requireProbability("geBadToGood", badToGood);
+    requireProbability("geLossGood", lossGood);
+    requireProbability("geLossBad", lossBad);
+}
+
+bool GilbertElliottLoss::dropNext()
+{
+    const double switchProbability = bad ? badToGood : goodToBad;
+    if (rng->doubleRand() < switchProbability)
+        bad = !bad;
+    return rng->doubleRand() < (bad ? lossBad : lossGood);
+}
+
+double GilbertElliottLoss::nominalLossRate() const
+{
+    const double transitions = goodToBad + badToGood;
+    const double badShare = transitions > 0 ? goodToBad / transitions : 0;
+    return (1 - badShare) * lossGood + badShare * lossBad;
+}
+
+std::unique_ptr<LossModel> createLossModel(cComponent *owner, bool queryDirection, double distance)
+{
+    const std::string kind = owner->par("lossModel").stdstringValue();
+    cRNG *rng = owner->getRNG(owner->par("lossRng").intValue());
+
+    if (kind == "none")
+        return std::make_unique<DeterministicLoss>(0);
+    if (kind == "deterministic") {
+        const int count = queryDirection ? owner->par("lostQueryCount").intValue() : 0;
+        return std::make_unique<DeterministicLoss>(count);
+    }
+    if (kind == "bernoulli")
+        return std::make_unique<BernoulliLoss>(rng, owner->par("lossProbability").doubleValue());
+    if (kind == "gilbertElliott") {
+        return std::make_unique<GilbertElliottLoss>(rng,
+            owner->par("geGoodToBad").doubleValue(), owner->par("geBadToGood").doubleValue(),
+            owner->par("geLossGood").doubleValue(), owner->par("geLossBad").doubleValue());
+    }
+    if (kind == "distance") {
+        // Loss grows with the path-loss exponent and becomes certain at lossRange.
+        const double range = owner->par("lossRange").doubleValue();
+        if (range <= 0)
+            throw cRuntimeError("lossRange must be positive, got %g", range);
+        const double probability = std::min(1.0, std::pow(distance / range, owner->par("lossExponent").doubleValue()));
+        return std::make_unique<BernoulliLoss>(rng, probability);
+    }
+
+    throw cRuntimeError("Unknown lossModel '%s' (expected none, deterministic, bernoulli, gilbertElliott or distance)", kind.c_str());
+}
+
+} // namespace garbage_collection
@@ -0,0 +1,82 @@
+#ifndef GARBAGE_COLLECTION_LOSSMODEL_H
+#define GARBAGE_COLLECTION_LOSSMODEL_H
+
+#include <omnetpp.h>
+#include <memory>
+
+namespace garbage_collection {
+
+/**
+ * Decides, packet by packet, whether one direction of a radio link loses a
+ * packet. Stochastic models draw from the RNG they were created with, so
+ * loss can be given its own stream independent of the rest of the model.
+ */
+class LossModel {
+  public:
+    virtual ~LossModel() = default;
+
+    /** Returns true when the next packet offered to the link is lost. */
+    virtual bool dropNext() = 0;
+
+    /** Long-run loss probability, reported alongside the measured rate. */
+    virtual double nominalLossRate() const = 0;
+};
+
+/** Drops the first count packets and delivers everything after them. */
+class DeterministicLoss : public LossModel {
+  public:
+    explicit DeterministicLoss(int count) : remaining(count) {}
+
+    bool dropNext() override;
+    double nominalLossRate() const override { return 0; }
+
+  private:
+    int remaining;
+};
+
+/** Loses every packet independently with the same probability. */
+class BernoulliLoss : public LossModel {
+  public:
+    BernoulliLoss(omnetpp::cRNG *rng, double probability);
+
+    bool dropNext() override;
+    double nominalLossRate() const override { return probability; }
+
+  private:
+    omnetpp::cRNG *rng;
+    double probability;
+};
+
+/**
+ * Two-state Markov channel: packets are lost with lossGood in the good state
+ * and lossBad in the bad state, and the state may change before each packet.
+ * Produces the loss bursts seen on fading radio links.
+ */
+class GilbertElliottLoss : public LossModel {
+  public:
+    GilbertElliottLoss(omnetpp::cRNG *rng, double goodToBad, double badToGood, double lossGood, double lossBad);
+
+    bool dropNext() override;
+    double nominalLossRate() const override;
+
+  private:
+    omnetpp::cRNG *rng;
+    double goodToBad;
+    double badToGood;
+    double lossGood;
+    double lossBad;
+    bool bad = false;
+};
+
+/**
+ * Builds the loss model selected by the module's lossModel parameter.
+ * Queries and responses each get their own instance with identical
+ * parameters; lostQueryCount only applies to the query direction of the
+ * deterministic model. distance is the link length on the canvas, used by
+ * the "distance" model.
+ */
+std::unique_ptr<LossModel> createLossModel(omnetpp::cComponent *owner, bool queryDirection, double distance);
+
+} // namespace garbage_collection
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef GARBAGE_COLLECTION_MESSAGECOUNTERS_H
+#define GARBAGE_COLLECTION_MESSAGECOUNTERS_H
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "CommandLabels.h"
+
+namespace garbage_collection {
+
+/**
+ * Fixed-size message counters for one traffic direction, indexed by opcode.
+ * Each opcode has two slots (can 0 and every other can) because the
+ * assignment labels differ between them; reports therefore list exactly the
+ * labels the old label-keyed maps did, without a tree walk or a string
+ * construction per packet.
+ */
+class MessageCounterTable {
+  public:
+    void note(GarbageOpcode opcode, int canId)
+    {
+        ++counts[slotFor(opcode, canId)];
+    }
+
+    void note(const GarbagePacket *pkt)
+    {
+        note(pkt->getOpcode(), pkt->getCanId());
+    }
+
+    bool empty() const
+    {
+        return std::all_of(counts.begin(), counts.end(), [](long count) { return count == 0; });
+    }
+
+    /**
+     * Lists every non-zero label with its count, in label order. With a
+     * counterpart table each line also states how many were matched by it
+     * and how many are still pending.
+     */
+    std::string describe(const MessageCounterTable *counterpart = nullptr) const
+    {
+        std::vector<int> slots;
+        for (int slot = 0; slot < kSlotCount; ++slot) {
+            if (counts[slot] > 0)
+                slots.push_back(slot);
+        }
+        if (slots.empty())
+            return "  none";
+
+        std::sort(slots.begin(), slots.end(), [](int a, int b) { return strcmp(labelFor(a), labelFor(b)) < 0; });
+
+        std::ostringstream oss;
+        for (size_t i = 0; i < slots.size(); ++i) {
+            const int slot = slots[i];
+            const long count = counts[slot];
+            const long other = counterpart ? counterpart->counts[slot] : 0;
+            const long pending = counterpart ? (count - other) : 0;
+            if (i > 0)
+                oss << "\n";
+            oss << "  " << labelFor(slot) << " x" << count;
+            if (counterpart && other > 0)
+                oss << " (matched " << other << ")";
+            if (counterpart && pending > 0)
+                oss << " (pending " << pending << ")";
+        }
+        return oss.str();
+    }
+
+  private:
+    static constexpr int kSlotCount = OP_COUNT * 2;
+
+    std::array<long, kSlotCount> counts {};
+
+    static int slotFor(GarbageOpcode opcode, int canId)
+    {
+        const int index = (opcode >= 0 && opcode < OP_COUNT) ? opcode : OP_NONE;
+        const int variant = (canId != 0 && hasPerCanLabel(opcode)) ? 1 : 0;
+        return index * 2 + variant;
+    }
+
+    static const char *labelFor(int slot)
+    {
+        return commandLabel(static_cast<GarbageOpcode>(slot / 2), slot % 2);
+    }
+};
+
+/** Report helper kept under the name the modules have always used. */
+inline std::string describeMessages(const MessageCounterTable &bucket, const MessageCounterTable *counterpart = nullptr)
+{
+    return bucket.describe(counterpart);
+}
+
+} // namespace garbage_collection
+
+#endif
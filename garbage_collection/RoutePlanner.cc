@@ -0,0 +1,113 @@
+#include "RoutePlanner.h"
+
+#include <omnetpp.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+using namespace omnetpp;
+
+namespace garbage_collection {
+
+RoutePlanner::RoutePlanner(std::vector<CanvasPoint> stops, CanvasPoint depot, Metric metric)
+    : positions(std::move(stops)), depot(depot), metric(metric), onTour(positions.size(), 0)
+{
+}
+
+double RoutePlanner::distance(const CanvasPoint &a, const CanvasPoint &b) const
+{
+    const double dx = a.x - b.x;
+    const double dy = a.y - b.y;
+    if (metric == Metric::Manhattan)
+        return std::fabs(dx) + std::fabs(dy);
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+const CanvasPoint &RoutePlanner::pointAt(long pos) const
+{
+    if (pos < 0 || pos >= long(order.size()))
+        return depot;
+    return positions[order[pos]];
+}
+
+void RoutePlanner::recomputeLength()
+{
+    tourLength = 0;
+    for (long pos = 0; pos <= long(order.size()); ++pos)
+        tourLength += distance(pointAt(pos - 1), pointAt(pos));
+}
+
+bool RoutePlanner::insert(int stop)
+{
+    if (stop < 0 || stop >= int(positions.size()))
+        throw cRuntimeError("Route stop %d out of range [0, %d)", stop, int(positions.size()));
+    if (onTour[stop])
+        return false;
+
+    const CanvasPoint &p = positions[stop];
+    long best = 0;
+    double bestDelta = std::numeric_limits<double>::infinity();
+    for (long pos = 0; pos <= long(order.size()); ++pos) {
+        const CanvasPoint &prev = pointAt(pos - 1);
+        const CanvasPoint &next = pointAt(pos);
+        const double delta = distance(prev, p) + distance(p, next) - distance(prev, next);
+        if (delta < bestDelta) {
+            bestDelta = delta;
+            best = pos;
+        }
+    }
+
+    order.insert(order.begin() + best, stop);
+    onTour[stop] = 1;
+    tourLength += bestDelta;
+    return true;
+}
+
+bool RoutePlanner::remove(int stop)
+{
+    if (stop < 0 || stop >= int(positions.size()) || !onTour[stop])
+        return false;
+
+    const long pos = std::find(order.begin(), order.end(), stop) - order.begin();
+    const CanvasPoint &prev = pointAt(pos - 1);
+    const CanvasPoint &next = pointAt(pos + 1);
+    tourLength -= distance(prev, positions[stop]) + distance(positions[stop], next) - distance(prev, next);
+    order.erase(order.begin() + pos);
+    onTour[stop] = 0;
+    if (order.empty())
+        tourLength = 0;
+    return true;
+}
+
+int RoutePlanner::improve(int maxPasses)
+{
+    // Reversing order[i..j] replaces the edges (i-1, i) and (j, j+1) with
+    // (i-1, j) and (i, j+1); the depot closes both ends.
+    constexpr double kMinGain = 1e-9;
+    const long n = order.size();
+    int moves = 0;
+    bool improved = n >= 2;
+    for (int pass = 0; improved && (maxPasses <= 0 || pass < maxPasses); ++pass) {
+        improved = false;
+        for (long i = 0; i < n - 1; ++i) {
+            for (long j = i + 1; j < n; ++j) {
+                const CanvasPoint &a = pointAt(i - 1);
+                const CanvasPoint &b = pointAt(i);
+                const CanvasPoint &c = pointAt(j);
+                const CanvasPoint &d = pointAt(j + 1);
+                const double gain = distance(a, b) + distance(c, d) - distance(a, c) - distance(b, d);
+                if (gain > kMinGain) {
+                    std::reverse(order.begin() + i, order.begin() + j + 1);
+                    ++moves;
+                    improved = true;
+                }
+            }
+        }
+    }
+    if (moves > 0)
+        recomputeLength();  // avoids drift from the incremental updates
+    return moves;
+}
+
+} // namespace garbage_collection
@@ -0,0 +1,69 @@
+#ifndef GARBAGE_COLLECTION_ROUTEPLANNER_H
+#define GARBAGE_COLLECTION_ROUTEPLANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace garbage_collection {
+
+/** A position on the canvas, in canvas units. */
+struct CanvasPoint {
+    double x = 0;
+    double y = 0;
+};
+
+/**
+ * Keeps a truck tour that starts and ends at the depot and visits a changing
+ * set of stops. Stops are added by cheapest insertion and removed by joining
+ * their neighbours, both in O(n), so the tour follows every change without
+ * being rebuilt; improve() then shortens it with 2-opt moves. Distances are
+ * symmetric, so a reversed tour segment keeps its length.
+ */
+class RoutePlanner {
+  public:
+    enum class Metric {
+        Euclidean,  //!< Straight lines.
+        Manhattan,  //!< Axis-parallel roads, as on the scenario canvas.
+    };
+
+    /** stops holds the position of every possible stop, indexed by stop id. */
+    RoutePlanner(std::vector<CanvasPoint> stops, CanvasPoint depot, Metric metric);
+
+    /** Adds a stop where it lengthens the tour least; false if already on it. */
+    bool insert(int stop);
+
+    /** Takes a stop off the tour; false if it was not on it. */
+    bool remove(int stop);
+
+    /**
+     * Applies improving 2-opt moves until none is left or maxPasses passes
+     * over the tour are done (0: no limit). Returns the number of moves.
+     */
+    int improve(int maxPasses);
+
+    int stopCount() const { return int(positions.size()); }
+    bool contains(int stop) const { return onTour[stop] != 0; }
+    double length() const { return tourLength; }
+    size_t size() const { return order.size(); }
+    const std::vector<int> &tour() const { return order; }
+
+  private:
+    double distance(const CanvasPoint &a, const CanvasPoint &b) const;
+
+    /** Position of the tour entry at pos, where -1 and size() are the depot. */
+    const CanvasPoint &pointAt(long pos) const;
+
+    void recomputeLength();
+
+    std::vector<CanvasPoint> positions;
+    CanvasPoint depot;
+    Metric metric;
+    std::vector<int> order;          //!< Stops in visiting order, depot excluded.
+    std::vector<uint8_t> onTour;     //!< Indexed by stop id.
+    double tourLength = 0;
+};
+
+} // namespace garbage_collection
+
+#endif
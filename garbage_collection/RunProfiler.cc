@@ -0,0 +1,99 @@
+#include <omnetpp.h>
+#include <sys/resource.h>
+#include <cstdio>
+#include "WallClock.h"
+
+using namespace omnetpp;
+using namespace garbage_collection;
+
+namespace {
+
+/** Peak resident set size of the process so far, in KiB. */
+long peakRssKiB()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return -1;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;  // bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+} // namespace
+
+/**
+ * Measures what a run costs on the host; see RunProfiler.ned.
+ *
+ * Setup time runs from this module's construction to its second
+ * initialization stage. Declared as the network's first submodule, it is
+ * constructed before the other modules are built, and since every other
+ * module initializes in stage 0, stage 1 is reached only once the whole
+ * network has been built and initialized. Warm-start loading, which happens
+ * in initialize(), is therefore part of the setup time. Run time runs from
+ * there to finish().
+ */
+class RunProfiler : public cSimpleModule {
+  private:
+        double constructedAt = wallClockSeconds();  //!< Approximates the start of network setup.
+        double runStartedAt = 0;                    //!< After the last initialization stage.
+        double setupSeconds = 0;
+
+    void appendSummaryRow(int numCans, int64_t events, double runSeconds, double eventsPerSecond, long rssKiB)
+    {
+        const std::string path = par("summaryFile").stdstringValue();
+        if (path.empty())
+            return;
+
+        FILE *file = std::fopen(path.c_str(), "a");
+        if (!file)
+            throw cRuntimeError("Cannot open run summary file '%s'", path.c_str());
+        std::fseek(file, 0, SEEK_END);
+        if (std::ftell(file) == 0)
+            std::fprintf(file, "runId,numCans,simTime,events,setupSeconds,runSeconds,eventsPerSecond,peakRssKiB\n");
+        std::fprintf(file, "%s,%d,%s,%lld,%.6f,%.6f,%.1f,%ld\n",
+            getEnvir()->getConfigEx()->getVariable(CFGVAR_RUNID), numCans, simTime().str().c_str(),
+            (long long)events, setupSeconds, runSeconds, eventsPerSecond, rssKiB);
+        std::fclose(file);
+    }
+
+  protected:
+    int numInitStages() const override
+    {
+        return 2;
+    }
+
+    void initialize(int stage) override
+    {
+        // Every other module initializes in stage 0.
+        if (stage == 1) {
+            runStartedAt = wallClockSeconds();
+            setupSeconds = runStartedAt - constructedAt;
+        }
+    }
+
+    void handleMessage(cMessage *msg) override
+    {
+        throw cRuntimeError("RunProfiler does not accept messages");
+    }
+
+    void finish() override
+    {
+        const double runSeconds = wallClockSeconds() - runStartedAt;
+        const int64_t events = getSimulation()->getEventNumber();
+        const double eventsPerSecond = runSeconds > 0 ? events / runSeconds : 0;
+        const long rssKiB = peakRssKiB();
+        cModule *network = getSimulation()->getSystemModule();
+        const int numCans = network->hasPar("numCans") ? network->par("numCans").intValue() : -1;
+
+        recordScalar("setupTime", setupSeconds, "s");
+        recordScalar("runTime", runSeconds, "s");
+        recordScalar("events", (double)events);
+        recordScalar("eventsPerSecond", eventsPerSecond);
+        recordScalar("peakRss", (double)rssKiB, "KiB");
+
+        appendSummaryRow(numCans, events, runSeconds, eventsPerSecond, rssKiB);
+    }
+};
+Define_Module(RunProfiler);
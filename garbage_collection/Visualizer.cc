@@ -1,26 +1,46 @@
 #include <omnetpp.h>
 #include <cmath>
 #include <cstdlib>
-#include <functional>
+#include <cstring>
 #include <sstream>
 #include <string>
 #include <vector>
+#include "FigureRegistry.h"
+#include "messages_m.h"
 
 using namespace omnetpp;
+using namespace garbage_collection;
 
 /**
- * Renders live wiring between system modules and displays scenario metrics
- * after the simulation completes.
+ * Renders live wiring between system modules and displays the mean measured
+ * one-way latency of each link class. The modules emit one latency signal
+ * per received packet; the visualizer listens for them on the system module
+ * only when figures are enabled, so batch runs pay nothing for it.
  */
-class GarbageVisualizer : public cSimpleModule {
+class GarbageVisualizer : public cSimpleModule, public cListener {
   private:
+    /** Mean latency shown in one value figure. */
     struct ValueBinding {
         const char *figureName;
         cTextFigure *figure = nullptr;
-        std::function<std::string()> compute;
+        long samples = 0;
+        double sumMs = 0;
+        bool dirty = false;
+    };
+
+    /**
+     * Figures fed by one latency signal: the link-class figures of the
+     * sending and receiving side, plus the per-can figure of can 0 or can 1
+     * when the packet belongs to one of them. Unused slots hold -1.
+     */
+    struct SignalRoute {
+        simsignal_t signal;
+        int linkBindings[2];
+        int canBindings[2];
     };
 
     std::vector<ValueBinding> delayBindings;
+    std::vector<SignalRoute> signalRoutes;
 
     cLineFigure *cloudHostLine = nullptr;
     cLineFigure *cloudCanLine = nullptr;
@@ -33,10 +53,13 @@ class GarbageVisualizer : public cSimpleModule {
     std::string scenarioTitle;
     std::string initialText;
     cModule *systemModule = nullptr;
-    bool resultsReady = false;
 
     static cFigure::Point moduleCenter(cModule *module)
     {
+        // Cans place themselves through parameters referenced as $posX/$posY.
+        if (module->hasPar("posX") && module->hasPar("posY"))
+            return {module->par("posX").doubleValue(), module->par("posY").doubleValue()};
+
         const char *xStr = module->getDisplayString().getTagArg("p", 0);
         const char *yStr = module->getDisplayString().getTagArg("p", 1);
         const double x = xStr && *xStr ? std::atof(xStr) : 0.0;
@@ -44,7 +67,7 @@ class GarbageVisualizer : public cSimpleModule {
         return {x, y};
     }
 
-    /** Converts a recorded statistic to a rounded printable string. */
+    /** Converts a latency in milliseconds to a rounded printable string. */
     static std::string formatResult(double value)
     {
         if (std::isnan(value))
@@ -53,6 +76,16 @@ class GarbageVisualizer : public cSimpleModule {
         return std::to_string(rounded);
     }
 
+    void addSample(int bindingIndex, double latencyMs)
+    {
+        if (bindingIndex < 0)
+            return;
+        ValueBinding &binding = delayBindings[bindingIndex];
+        ++binding.samples;
+        binding.sumMs += latencyMs;
+        binding.dirty = true;
+    }
+
     static void updateLine(cLineFigure *line, cModule *a, cModule *b)
     {
         if (!line || !a || !b)
@@ -72,9 +105,10 @@ class GarbageVisualizer : public cSimpleModule {
     void updateDelayTexts()
     {
         for (auto &binding : delayBindings) {
-            if (!binding.figure || !binding.compute)
+            if (!binding.figure || !binding.dirty)
                 continue;
-            const std::string value = binding.compute();
+            binding.dirty = false;
+            const std::string value = formatResult(binding.sumMs / binding.samples);
             binding.figure->setText(value.c_str());
         }
     }
@@ -97,14 +131,10 @@ class GarbageVisualizer : public cSimpleModule {
         return found;
     }
 
-    /** Locates a mandatory text figure on the canvas. */
-    cTextFigure *requireTextFigure(const char *figureName)
+    /** Locates a text figure on the canvas through the shared registry; nullptr if absent. */
+    cTextFigure *findTextFigure(const char *figureName)
     {
-        cCanvas *canvas = systemModule->getCanvas();
-        auto *figure = canvas->getFigure(figureName);
-        if (!figure)
-            throw cRuntimeError("GarbageVisualizer: missing figure '%s'", figureName);
-        return check_and_cast<cTextFigure *>(figure);
+        return garbage_collection::findTextFigure(this, figureName);
     }
 
     /** Helper for configuring the lines linking cloud to other modules. */
@@ -119,23 +149,36 @@ class GarbageVisualizer : public cSimpleModule {
         return line;
     }
 
-    void registerBinding(const char *figureName, const char *parameterName)
+    /** Returns the index of the binding for a value figure, creating it on first use. */
+    int bindingFor(const char *figureName)
     {
+        if (!figureName)
+            return -1;
+        for (size_t i = 0; i < delayBindings.size(); ++i) {
+            if (strcmp(delayBindings[i].figureName, figureName) == 0)
+                return static_cast<int>(i);
+        }
+
         ValueBinding binding;
         binding.figureName = figureName;
-        binding.figure = requireTextFigure(figureName);
-        binding.figure->setText(initialText.c_str());
-        if (!systemModule->hasPar(parameterName)) {
-            EV_WARN << "GarbageVisualizer: statistic parameter '" << parameterName
-                    << "' not found; figure '" << figureName << "' will stay blank" << endl;
-            binding.compute = []() { return std::string(); };
-        }
-        else {
-            binding.compute = [this, parameterName]() {
-                return formatResult(systemModule->par(parameterName).doubleValue());
-            };
-        }
-        delayBindings.push_back(std::move(binding));
+        binding.figure = findTextFigure(figureName);
+        if (binding.figure)
+            binding.figure->setText(initialText.c_str());
+        delayBindings.push_back(binding);
+        return static_cast<int>(delayBindings.size()) - 1;
+    }
+
+    void registerRoute(const char *signalName, const char *senderFigure, const char *receiverFigure,
+        const char *canFigure, const char *anotherCanFigure)
+    {
+        SignalRoute route;
+        route.signal = registerSignal(signalName);
+        route.linkBindings[0] = bindingFor(senderFigure);
+        route.linkBindings[1] = bindingFor(receiverFigure);
+        route.canBindings[0] = bindingFor(canFigure);
+        route.canBindings[1] = bindingFor(anotherCanFigure);
+        signalRoutes.push_back(route);
+        systemModule->subscribe(route.signal, this);
     }
 
   protected:
@@ -150,48 +193,48 @@ class GarbageVisualizer : public cSimpleModule {
         }
         systemModule = requireSystemModule();
 
-        cloudModule = requireSubmodule("cloud");
+        // Everything below only decorates the canvas. The module lookups are
+        // kept here too: under parallel simulation the other modules may be
+        // placeholders in another partition, and batch runs never draw.
+        if (!figuresEnabled())
+            return;
+
+        cloudModule = requireSubmodule("cloud", 0);
         hostModule = requireSubmodule("host", 0);
-        canModule = requireSubmodule("can");
-        anotherCanModule = requireSubmodule("anotherCan");
+        canModule = requireSubmodule("can", 0);
+        anotherCanModule = systemModule->getSubmodule("can", 1);
 
         cloudHostLine = createLinkLine("cloudHostLine");
         cloudCanLine = createLinkLine("cloudCanLine");
         cloudAnotherCanLine = createLinkLine("cloudAnotherCanLine");
 
-        headingFigure = requireTextFigure("infoHeading");
-        headingFigure->setText(scenarioTitle.c_str());
-
-        static const struct {
-            const char *figureName;
-            const char *parameterName;
-        } kBindingSpecs[] = {
-            {"smartSlowOutValue", "smartSlowOutResult"},
-            {"smartSlowInValue", "smartSlowInResult"},
-            {"smartFastOutValue", "smartFastOutResult"},
-            {"smartFastInValue", "smartFastInResult"},
-            {"canOutValue", "canOutResult"},
-            {"canInValue", "canInResult"},
-            {"anotherCanOutValue", "anotherCanOutResult"},
-            {"anotherCanInValue", "anotherCanInResult"},
-            {"cloudSlowOutValue", "cloudSlowOutResult"},
-            {"cloudSlowInValue", "cloudSlowInResult"},
-            {"cloudFastOutValue", "cloudFastOutResult"},
-            {"cloudFastInValue", "cloudFastInResult"}
-        };
-
-        const size_t bindingCount = sizeof(kBindingSpecs) / sizeof(kBindingSpecs[0]);
-        delayBindings.reserve(delayBindings.size() + bindingCount);
-        for (size_t i = 0; i < bindingCount; ++i)
-            registerBinding(kBindingSpecs[i].figureName, kBindingSpecs[i].parameterName);
+        headingFigure = findTextFigure("infoHeading");
+        if (headingFigure)
+            headingFigure->setText(scenarioTitle.c_str());
+
+        // Can traffic additionally feeds the figure of the can it came from or went to.
+        registerRoute("hostToCloudLatency", "smartSlowOutValue", "cloudSlowInValue", nullptr, nullptr);
+        registerRoute("cloudToHostLatency", "cloudSlowOutValue", "smartSlowInValue", nullptr, nullptr);
+        registerRoute("hostToCanLatency", "smartFastOutValue", nullptr, "canInValue", "anotherCanInValue");
+        registerRoute("canToHostLatency", nullptr, "smartFastInValue", "canOutValue", "anotherCanOutValue");
+        registerRoute("cloudToCanLatency", "cloudFastOutValue", nullptr, "canInValue", "anotherCanInValue");
+        registerRoute("canToCloudLatency", nullptr, "cloudFastInValue", "canOutValue", "anotherCanOutValue");
 
         updateLines();
     }
 
-    void finish() override
+    void receiveSignal(cComponent *source, simsignal_t signalID, const SimTime &latency, cObject *details) override
     {
-        resultsReady = true;
-        updateDelayTexts();
+        const double latencyMs = SIMTIME_DBL(latency) * 1000;
+        for (const auto &route : signalRoutes) {
+            if (route.signal != signalID)
+                continue;
+            addSample(route.linkBindings[0], latencyMs);
+            addSample(route.linkBindings[1], latencyMs);
+            auto *pkt = dynamic_cast<GarbagePacket *>(details);
+            if (pkt && pkt->getCanId() >= 0 && pkt->getCanId() < 2)
+                addSample(route.canBindings[pkt->getCanId()], latencyMs);
+        }
     }
 
     void handleMessage(cMessage *msg) override
@@ -202,8 +245,14 @@ class GarbageVisualizer : public cSimpleModule {
     void refreshDisplay() const override
     {
         const_cast<GarbageVisualizer *>(this)->updateLines();
-        if (resultsReady)
-            const_cast<GarbageVisualizer *>(this)->updateDelayTexts();
+        const_cast<GarbageVisualizer *>(this)->updateDelayTexts();
+    }
+
+  public:
+    ~GarbageVisualizer() override
+    {
+        for (const auto &route : signalRoutes)
+            systemModule->unsubscribe(route.signal, this);
     }
 };
 Define_Module(GarbageVisualizer);
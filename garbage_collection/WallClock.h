@@ -0,0 +1,22 @@
+#ifndef GARBAGE_COLLECTION_WALLCLOCK_H
+#define GARBAGE_COLLECTION_WALLCLOCK_H
+
+#include <chrono>
+
+namespace garbage_collection {
+
+/**
+ * Seconds on the host's monotonic clock, for measuring how long the
+ * simulation itself takes; only differences between two readings mean
+ * anything. Used by the run profiler, the route planner timing and the
+ * handler benchmark.
+ */
+inline double wallClockSeconds()
+{
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace garbage_collection
+
+#endif
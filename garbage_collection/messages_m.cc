@@ -152,6 +152,8 @@ void doParsimUnpacking(omnetpp::cCommBuffer *, T& t)
 
 namespace garbage_collection {
 
+Register_Enum(garbage_collection::GarbageOpcode, (garbage_collection::GarbageOpcode::OP_NONE, garbage_collection::GarbageOpcode::OP_QUERY, garbage_collection::GarbageOpcode::OP_STATUS_NO, garbage_collection::GarbageOpcode::OP_STATUS_YES, garbage_collection::GarbageOpcode::OP_COLLECT, garbage_collection::GarbageOpcode::OP_COLLECT_ACK, garbage_collection::GarbageOpcode::OP_CLOUD_ACK, garbage_collection::GarbageOpcode::OP_NOTIFY, garbage_collection::GarbageOpcode::OP_NOTIFY_ACK, garbage_collection::GarbageOpcode::OP_HEARTBEAT, garbage_collection::GarbageOpcode::OP_SUMMARY, garbage_collection::GarbageOpcode::OP_SUMMARY_ACK, garbage_collection::GarbageOpcode::OP_LOAD_REPORT, garbage_collection::GarbageOpcode::OP_STEAL_ORDER, garbage_collection::GarbageOpcode::OP_STEAL_GRANT, garbage_collection::GarbageOpcode::OP_SHARD_HANDOFF, garbage_collection::GarbageOpcode::OP_CLOUD_BUSY, garbage_collection::GarbageOpcode::OP_BACKPRESSURE, garbage_collection::GarbageOpcode::OP_COUNT));
+
 Register_Class(GarbagePacket)
 
 GarbagePacket::GarbagePacket(const char *name, short kind) : ::omnetpp::cPacket(name, kind)
@@ -177,41 +179,47 @@ GarbagePacket& GarbagePacket::operator=(const GarbagePacket& other)
 
 void GarbagePacket::copy(const GarbagePacket& other)
 {
-    this->command = other.command;
+    this->opcode = other.opcode;
     this->canId = other.canId;
     this->isFull_ = other.isFull_;
     this->travelTime = other.travelTime;
     this->note = other.note;
+    this->requestId = other.requestId;
+    this->attempt = other.attempt;
 }
 
 void GarbagePacket::parsimPack(omnetpp::cCommBuffer *b) const
 {
     ::omnetpp::cPacket::parsimPack(b);
-    doParsimPacking(b,this->command);
+    doParsimPacking(b,this->opcode);
     doParsimPacking(b,this->canId);
     doParsimPacking(b,this->isFull_);
     doParsimPacking(b,this->travelTime);
     doParsimPacking(b,this->note);
+    doParsimPacking(b,this->requestId);
+    doParsimPacking(b,this->attempt);
 }
 
 void GarbagePacket::parsimUnpack(omnetpp::cCommBuffer *b)
 {
     ::omnetpp::cPacket::parsimUnpack(b);
-    doParsimUnpacking(b,this->command);
+    doParsimUnpacking(b,this->opcode);
     doParsimUnpacking(b,this->canId);
     doParsimUnpacking(b,this->isFull_);
     doParsimUnpacking(b,this->travelTime);
     doParsimUnpacking(b,this->note);
+    doParsimUnpacking(b,this->requestId);
+    doParsimUnpacking(b,this->attempt);
 }
 
-const char * GarbagePacket::getCommand() const
+GarbageOpcode GarbagePacket::getOpcode() const
 {
-    return this->command.c_str();
+    return this->opcode;
 }
 
-void GarbagePacket::setCommand(const char * command)
+void GarbagePacket::setOpcode(GarbageOpcode opcode)
 {
-    this->command = command;
+    this->opcode = opcode;
 }
 
 int GarbagePacket::getCanId() const
@@ -254,16 +262,38 @@ void GarbagePacket::setNote(const char * note)
     this->note = note;
 }
 
+long GarbagePacket::getRequestId() const
+{
+    return this->requestId;
+}
+
+void GarbagePacket::setRequestId(long requestId)
+{
+    this->requestId = requestId;
+}
+
+int GarbagePacket::getAttempt() const
+{
+    return this->attempt;
+}
+
+void GarbagePacket::setAttempt(int attempt)
+{
+    this->attempt = attempt;
+}
+
 class GarbagePacketDescriptor : public omnetpp::cClassDescriptor
 {
   private:
     mutable const char **propertyNames;
     enum FieldConstants {
-        FIELD_command,
+        FIELD_opcode,
         FIELD_canId,
         FIELD_isFull,
         FIELD_travelTime,
         FIELD_note,
+        FIELD_requestId,
+        FIELD_attempt,
     };
   public:
     GarbagePacketDescriptor();
@@ -330,7 +360,7 @@ const char *GarbagePacketDescriptor::getProperty(const char *propertyName) const
 int GarbagePacketDescriptor::getFieldCount() const
 {
     omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
-    return base ? 5+base->getFieldCount() : 5;
+    return base ? 7+base->getFieldCount() : 7;
 }
 
 unsigned int GarbagePacketDescriptor::getFieldTypeFlags(int field) const
@@ -342,13 +372,15 @@ unsigned int GarbagePacketDescriptor::getFieldTypeFlags(int field) const
         field -= base->getFieldCount();
     }
     static unsigned int fieldTypeFlags[] = {
-        FD_ISEDITABLE,    // FIELD_command
+        FD_ISEDITABLE,    // FIELD_opcode
         FD_ISEDITABLE,    // FIELD_canId
         FD_ISEDITABLE,    // FIELD_isFull
         FD_ISEDITABLE,    // FIELD_travelTime
         FD_ISEDITABLE,    // FIELD_note
+        FD_ISEDITABLE,    // FIELD_requestId
+        FD_ISEDITABLE,    // FIELD_attempt
     };
-    return (field >= 0 && field < 5) ? fieldTypeFlags[field] : 0;
+    return (field >= 0 && field < 7) ? fieldTypeFlags[field] : 0;
 }
 
 const char *GarbagePacketDescriptor::getFieldName(int field) const
@@ -360,24 +392,28 @@ const char *GarbagePacketDescriptor::getFieldName(int field) const
         field -= base->getFieldCount();
     }
     static const char *fieldNames[] = {
-        "command",
+        "opcode",
         "canId",
         "isFull",
         "travelTime",
         "note",
+        "requestId",
+        "attempt",
     };
-    return (field >= 0 && field < 5) ? fieldNames[field] : nullptr;
+    return (field >= 0 && field < 7) ? fieldNames[field] : nullptr;
 }
 
 int GarbagePacketDescriptor::findField(const char *fieldName) const
 {
     omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
     int baseIndex = base ? base->getFieldCount() : 0;
-    if (strcmp(fieldName, "command") == 0) return baseIndex + 0;
+    if (strcmp(fieldName, "opcode") == 0) return baseIndex + 0;
     if (strcmp(fieldName, "canId") == 0) return baseIndex + 1;
     if (strcmp(fieldName, "isFull") == 0) return baseIndex + 2;
     if (strcmp(fieldName, "travelTime") == 0) return baseIndex + 3;
     if (strcmp(fieldName, "note") == 0) return baseIndex + 4;
+    if (strcmp(fieldName, "requestId") == 0) return baseIndex + 5;
+    if (strcmp(fieldName, "attempt") == 0) return baseIndex + 6;
     return base ? base->findField(fieldName) : -1;
 }
 
@@ -390,13 +426,15 @@ const char *GarbagePacketDescriptor::getFieldTypeString(int field) const
         field -= base->getFieldCount();
     }
     static const char *fieldTypeStrings[] = {
-        "string",    // FIELD_command
+        "garbage_collection::GarbageOpcode",    // FIELD_opcode
         "int",    // FIELD_canId
         "bool",    // FIELD_isFull
         "double",    // FIELD_travelTime
         "string",    // FIELD_note
+        "long",    // FIELD_requestId
+        "int",    // FIELD_attempt
     };
-    return (field >= 0 && field < 5) ? fieldTypeStrings[field] : nullptr;
+    return (field >= 0 && field < 7) ? fieldTypeStrings[field] : nullptr;
 }
 
 const char **GarbagePacketDescriptor::getFieldPropertyNames(int field) const
@@ -408,6 +446,10 @@ const char **GarbagePacketDescriptor::getFieldPropertyNames(int field) const
         field -= base->getFieldCount();
     }
     switch (field) {
+        case FIELD_opcode: {
+            static const char *names[] = { "enum",  nullptr };
+            return names;
+        }
         default: return nullptr;
     }
 }
@@ -421,6 +463,9 @@ const char *GarbagePacketDescriptor::getFieldProperty(int field, const char *pro
         field -= base->getFieldCount();
     }
     switch (field) {
+        case FIELD_opcode:
+            if (!strcmp(propertyName, "enum")) return "garbage_collection::GarbageOpcode";
+            return nullptr;
         default: return nullptr;
     }
 }
@@ -479,11 +524,13 @@ std::string GarbagePacketDescriptor::getFieldValueAsString(omnetpp::any_ptr obje
     }
     GarbagePacket *pp = omnetpp::fromAnyPtr<GarbagePacket>(object); (void)pp;
     switch (field) {
-        case FIELD_command: return oppstring2string(pp->getCommand());
+        case FIELD_opcode: return enum2string(pp->getOpcode(), "garbage_collection::GarbageOpcode");
         case FIELD_canId: return long2string(pp->getCanId());
         case FIELD_isFull: return bool2string(pp->isFull());
         case FIELD_travelTime: return double2string(pp->getTravelTime());
         case FIELD_note: return oppstring2string(pp->getNote());
+        case FIELD_requestId: return long2string(pp->getRequestId());
+        case FIELD_attempt: return long2string(pp->getAttempt());
         default: return "";
     }
 }
@@ -500,11 +547,13 @@ void GarbagePacketDescriptor::setFieldValueAsString(omnetpp::any_ptr object, int
     }
     GarbagePacket *pp = omnetpp::fromAnyPtr<GarbagePacket>(object); (void)pp;
     switch (field) {
-        case FIELD_command: pp->setCommand((value)); break;
+        case FIELD_opcode: pp->setOpcode((garbage_collection::GarbageOpcode)string2enum(value, "garbage_collection::GarbageOpcode")); break;
         case FIELD_canId: pp->setCanId(string2long(value)); break;
         case FIELD_isFull: pp->setIsFull(string2bool(value)); break;
         case FIELD_travelTime: pp->setTravelTime(string2double(value)); break;
         case FIELD_note: pp->setNote((value)); break;
+        case FIELD_requestId: pp->setRequestId(string2long(value)); break;
+        case FIELD_attempt: pp->setAttempt(string2long(value)); break;
         default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'GarbagePacket'", field);
     }
 }
@@ -519,11 +568,13 @@ omnetpp::cValue GarbagePacketDescriptor::getFieldValue(omnetpp::any_ptr object,
     }
     GarbagePacket *pp = omnetpp::fromAnyPtr<GarbagePacket>(object); (void)pp;
     switch (field) {
-        case FIELD_command: return pp->getCommand();
+        case FIELD_opcode: return static_cast<int>(pp->getOpcode());
         case FIELD_canId: return pp->getCanId();
         case FIELD_isFull: return pp->isFull();
         case FIELD_travelTime: return pp->getTravelTime();
         case FIELD_note: return pp->getNote();
+        case FIELD_requestId: return (omnetpp::intval_t)(pp->getRequestId());
+        case FIELD_attempt: return pp->getAttempt();
         default: throw omnetpp::cRuntimeError("Cannot return field %d of class 'GarbagePacket' as cValue -- field index out of range?", field);
     }
 }
@@ -540,11 +591,13 @@ void GarbagePacketDescriptor::setFieldValue(omnetpp::any_ptr object, int field,
     }
     GarbagePacket *pp = omnetpp::fromAnyPtr<GarbagePacket>(object); (void)pp;
     switch (field) {
-        case FIELD_command: pp->setCommand(value.stringValue()); break;
+        case FIELD_opcode: pp->setOpcode(static_cast<garbage_collection::GarbageOpcode>(value.intValue())); break;
         case FIELD_canId: pp->setCanId(omnetpp::checked_int_cast<int>(value.intValue())); break;
         case FIELD_isFull: pp->setIsFull(value.boolValue()); break;
         case FIELD_travelTime: pp->setTravelTime(value.doubleValue()); break;
         case FIELD_note: pp->setNote(value.stringValue()); break;
+        case FIELD_requestId: pp->setRequestId(omnetpp::checked_int_cast<long>(value.intValue())); break;
+        case FIELD_attempt: pp->setAttempt(omnetpp::checked_int_cast<int>(value.intValue())); break;
         default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'GarbagePacket'", field);
     }
 }
@@ -592,6 +645,2187 @@ void GarbagePacketDescriptor::setFieldStructValuePointer(omnetpp::any_ptr object
     }
 }
 
+Register_Class(CanTimer)
+
+CanTimer::CanTimer(const char *name, short kind) : ::omnetpp::cMessage(name, kind)
+{
+}
+
+CanTimer::CanTimer(const CanTimer& other) : ::omnetpp::cMessage(other)
+{
+    copy(other);
+}
+
+CanTimer::~CanTimer()
+{
+}
+
+CanTimer& CanTimer::operator=(const CanTimer& other)
+{
+    if (this == &other) return *this;
+    ::omnetpp::cMessage::operator=(other);
+    copy(other);
+    return *this;
+}
+
+void CanTimer::copy(const CanTimer& other)
+{
+    this->canId = other.canId;
+}
+
+void CanTimer::parsimPack(omnetpp::cCommBuffer *b) const
+{
+    ::omnetpp::cMessage::parsimPack(b);
+    doParsimPacking(b,this->canId);
+}
+
+void CanTimer::parsimUnpack(omnetpp::cCommBuffer *b)
+{
+    ::omnetpp::cMessage::parsimUnpack(b);
+    doParsimUnpacking(b,this->canId);
+}
+
+int CanTimer::getCanId() const
+{
+    return this->canId;
+}
+
+void CanTimer::setCanId(int canId)
+{
+    this->canId = canId;
+}
+
+class CanTimerDescriptor : public omnetpp::cClassDescriptor
+{
+  private:
+    mutable const char **propertyNames;
+    enum FieldConstants {
+        FIELD_canId,
+    };
+  public:
+    CanTimerDescriptor();
+    virtual ~CanTimerDescriptor();
+
+    virtual bool doesSupport(omnetpp::cObject *obj) const override;
+    virtual const char **getPropertyNames() const override;
+    virtual const char *getProperty(const char *propertyName) const override;
+    virtual int getFieldCount() const override;
+    virtual const char *getFieldName(int field) const override;
+    virtual int findField(const char *fieldName) const override;
+    virtual unsigned int getFieldTypeFlags(int field) const override;
+    virtual const char *getFieldTypeString(int field) const override;
+    virtual const char **getFieldPropertyNames(int field) const override;
+    virtual const char *getFieldProperty(int field, const char *propertyName) const override;
+    virtual int getFieldArraySize(omnetpp::any_ptr object, int field) const override;
+    virtual void setFieldArraySize(omnetpp::any_ptr object, int field, int size) const override;
+
+    virtual const char *getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual std::string getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const override;
+    virtual omnetpp::cValue getFieldValue(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const override;
+
+    virtual const char *getFieldStructName(int field) const override;
+    virtual omnetpp::any_ptr getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const override;
+};
+
+Register_ClassDescriptor(CanTimerDescriptor)
+
+CanTimerDescriptor::CanTimerDescriptor() : omnetpp::cClassDescriptor(omnetpp::opp_typename(typeid(garbage_collection::CanTimer)), "omnetpp::cMessage")
+{
+    propertyNames = nullptr;
+}
+
+CanTimerDescriptor::~CanTimerDescriptor()
+{
+    delete[] propertyNames;
+}
+
+bool CanTimerDescriptor::doesSupport(omnetpp::cObject *obj) const
+{
+    return dynamic_cast<CanTimer *>(obj)!=nullptr;
+}
+
+const char **CanTimerDescriptor::getPropertyNames() const
+{
+    if (!propertyNames) {
+        static const char *names[] = {  nullptr };
+        omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+        const char **baseNames = base ? base->getPropertyNames() : nullptr;
+        propertyNames = mergeLists(baseNames, names);
+    }
+    return propertyNames;
+}
+
+const char *CanTimerDescriptor::getProperty(const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? base->getProperty(propertyName) : nullptr;
+}
+
+int CanTimerDescriptor::getFieldCount() const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? 1+base->getFieldCount() : 1;
+}
+
+unsigned int CanTimerDescriptor::getFieldTypeFlags(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeFlags(field);
+        field -= base->getFieldCount();
+    }
+    static unsigned int fieldTypeFlags[] = {
+        FD_ISEDITABLE,    // FIELD_canId
+    };
+    return (field >= 0 && field < 1) ? fieldTypeFlags[field] : 0;
+}
+
+const char *CanTimerDescriptor::getFieldName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldName(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldNames[] = {
+        "canId",
+    };
+    return (field >= 0 && field < 1) ? fieldNames[field] : nullptr;
+}
+
+int CanTimerDescriptor::findField(const char *fieldName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    int baseIndex = base ? base->getFieldCount() : 0;
+    if (strcmp(fieldName, "canId") == 0) return baseIndex + 0;
+    return base ? base->findField(fieldName) : -1;
+}
+
+const char *CanTimerDescriptor::getFieldTypeString(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeString(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldTypeStrings[] = {
+        "int",    // FIELD_canId
+    };
+    return (field >= 0 && field < 1) ? fieldTypeStrings[field] : nullptr;
+}
+
+const char **CanTimerDescriptor::getFieldPropertyNames(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldPropertyNames(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+const char *CanTimerDescriptor::getFieldProperty(int field, const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldProperty(field, propertyName);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+int CanTimerDescriptor::getFieldArraySize(omnetpp::any_ptr object, int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldArraySize(object, field);
+        field -= base->getFieldCount();
+    }
+    CanTimer *pp = omnetpp::fromAnyPtr<CanTimer>(object); (void)pp;
+    switch (field) {
+        default: return 0;
+    }
+}
+
+void CanTimerDescriptor::setFieldArraySize(omnetpp::any_ptr object, int field, int size) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldArraySize(object, field, size);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    CanTimer *pp = omnetpp::fromAnyPtr<CanTimer>(object); (void)pp;
+    switch (field) {
+        default: throw omnetpp::cRuntimeError("Cannot set array size of field %d of class 'CanTimer'", field);
+    }
+}
+
+const char *CanTimerDescriptor::getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldDynamicTypeString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    CanTimer *pp = omnetpp::fromAnyPtr<CanTimer>(object); (void)pp;
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+std::string CanTimerDescriptor::getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValueAsString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    CanTimer *pp = omnetpp::fromAnyPtr<CanTimer>(object); (void)pp;
+    switch (field) {
+        case FIELD_canId: return long2string(pp->getCanId());
+        default: return "";
+    }
+}
+
+void CanTimerDescriptor::setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValueAsString(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    CanTimer *pp = omnetpp::fromAnyPtr<CanTimer>(object); (void)pp;
+    switch (field) {
+        case FIELD_canId: pp->setCanId(string2long(value)); break;
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'CanTimer'", field);
+    }
+}
+
+omnetpp::cValue CanTimerDescriptor::getFieldValue(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValue(object,field,i);
+        field -= base->getFieldCount();
+    }
+    CanTimer *pp = omnetpp::fromAnyPtr<CanTimer>(object); (void)pp;
+    switch (field) {
+        case FIELD_canId: return pp->getCanId();
+        default: throw omnetpp::cRuntimeError("Cannot return field %d of class 'CanTimer' as cValue -- field index out of range?", field);
+    }
+}
+
+void CanTimerDescriptor::setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValue(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    CanTimer *pp = omnetpp::fromAnyPtr<CanTimer>(object); (void)pp;
+    switch (field) {
+        case FIELD_canId: pp->setCanId(omnetpp::checked_int_cast<int>(value.intValue())); break;
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'CanTimer'", field);
+    }
+}
+
+const char *CanTimerDescriptor::getFieldStructName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructName(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    };
+}
+
+omnetpp::any_ptr CanTimerDescriptor::getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructValuePointer(object, field, i);
+        field -= base->getFieldCount();
+    }
+    CanTimer *pp = omnetpp::fromAnyPtr<CanTimer>(object); (void)pp;
+    switch (field) {
+        default: return omnetpp::any_ptr(nullptr);
+    }
+}
+
+void CanTimerDescriptor::setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldStructValuePointer(object, field, i, ptr);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    CanTimer *pp = omnetpp::fromAnyPtr<CanTimer>(object); (void)pp;
+    switch (field) {
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'CanTimer'", field);
+    }
+}
+
+Register_Class(CollectTimer)
+
+CollectTimer::CollectTimer(const char *name, short kind) : ::omnetpp::cMessage(name, kind)
+{
+}
+
+CollectTimer::CollectTimer(const CollectTimer& other) : ::omnetpp::cMessage(other)
+{
+    copy(other);
+}
+
+CollectTimer::~CollectTimer()
+{
+}
+
+CollectTimer& CollectTimer::operator=(const CollectTimer& other)
+{
+    if (this == &other) return *this;
+    ::omnetpp::cMessage::operator=(other);
+    copy(other);
+    return *this;
+}
+
+void CollectTimer::copy(const CollectTimer& other)
+{
+    this->requestId = other.requestId;
+}
+
+void CollectTimer::parsimPack(omnetpp::cCommBuffer *b) const
+{
+    ::omnetpp::cMessage::parsimPack(b);
+    doParsimPacking(b,this->requestId);
+}
+
+void CollectTimer::parsimUnpack(omnetpp::cCommBuffer *b)
+{
+    ::omnetpp::cMessage::parsimUnpack(b);
+    doParsimUnpacking(b,this->requestId);
+}
+
+long CollectTimer::getRequestId() const
+{
+    return this->requestId;
+}
+
+void CollectTimer::setRequestId(long requestId)
+{
+    this->requestId = requestId;
+}
+
+class CollectTimerDescriptor : public omnetpp::cClassDescriptor
+{
+  private:
+    mutable const char **propertyNames;
+    enum FieldConstants {
+        FIELD_requestId,
+    };
+  public:
+    CollectTimerDescriptor();
+    virtual ~CollectTimerDescriptor();
+
+    virtual bool doesSupport(omnetpp::cObject *obj) const override;
+    virtual const char **getPropertyNames() const override;
+    virtual const char *getProperty(const char *propertyName) const override;
+    virtual int getFieldCount() const override;
+    virtual const char *getFieldName(int field) const override;
+    virtual int findField(const char *fieldName) const override;
+    virtual unsigned int getFieldTypeFlags(int field) const override;
+    virtual const char *getFieldTypeString(int field) const override;
+    virtual const char **getFieldPropertyNames(int field) const override;
+    virtual const char *getFieldProperty(int field, const char *propertyName) const override;
+    virtual int getFieldArraySize(omnetpp::any_ptr object, int field) const override;
+    virtual void setFieldArraySize(omnetpp::any_ptr object, int field, int size) const override;
+
+    virtual const char *getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual std::string getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const override;
+    virtual omnetpp::cValue getFieldValue(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const override;
+
+    virtual const char *getFieldStructName(int field) const override;
+    virtual omnetpp::any_ptr getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const override;
+};
+
+Register_ClassDescriptor(CollectTimerDescriptor)
+
+CollectTimerDescriptor::CollectTimerDescriptor() : omnetpp::cClassDescriptor(omnetpp::opp_typename(typeid(garbage_collection::CollectTimer)), "omnetpp::cMessage")
+{
+    propertyNames = nullptr;
+}
+
+CollectTimerDescriptor::~CollectTimerDescriptor()
+{
+    delete[] propertyNames;
+}
+
+bool CollectTimerDescriptor::doesSupport(omnetpp::cObject *obj) const
+{
+    return dynamic_cast<CollectTimer *>(obj)!=nullptr;
+}
+
+const char **CollectTimerDescriptor::getPropertyNames() const
+{
+    if (!propertyNames) {
+        static const char *names[] = {  nullptr };
+        omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+        const char **baseNames = base ? base->getPropertyNames() : nullptr;
+        propertyNames = mergeLists(baseNames, names);
+    }
+    return propertyNames;
+}
+
+const char *CollectTimerDescriptor::getProperty(const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? base->getProperty(propertyName) : nullptr;
+}
+
+int CollectTimerDescriptor::getFieldCount() const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? 1+base->getFieldCount() : 1;
+}
+
+unsigned int CollectTimerDescriptor::getFieldTypeFlags(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeFlags(field);
+        field -= base->getFieldCount();
+    }
+    static unsigned int fieldTypeFlags[] = {
+        FD_ISEDITABLE,    // FIELD_requestId
+    };
+    return (field >= 0 && field < 1) ? fieldTypeFlags[field] : 0;
+}
+
+const char *CollectTimerDescriptor::getFieldName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldName(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldNames[] = {
+        "requestId",
+    };
+    return (field >= 0 && field < 1) ? fieldNames[field] : nullptr;
+}
+
+int CollectTimerDescriptor::findField(const char *fieldName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    int baseIndex = base ? base->getFieldCount() : 0;
+    if (strcmp(fieldName, "requestId") == 0) return baseIndex + 0;
+    return base ? base->findField(fieldName) : -1;
+}
+
+const char *CollectTimerDescriptor::getFieldTypeString(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeString(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldTypeStrings[] = {
+        "long",    // FIELD_requestId
+    };
+    return (field >= 0 && field < 1) ? fieldTypeStrings[field] : nullptr;
+}
+
+const char **CollectTimerDescriptor::getFieldPropertyNames(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldPropertyNames(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+const char *CollectTimerDescriptor::getFieldProperty(int field, const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldProperty(field, propertyName);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+int CollectTimerDescriptor::getFieldArraySize(omnetpp::any_ptr object, int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldArraySize(object, field);
+        field -= base->getFieldCount();
+    }
+    CollectTimer *pp = omnetpp::fromAnyPtr<CollectTimer>(object); (void)pp;
+    switch (field) {
+        default: return 0;
+    }
+}
+
+void CollectTimerDescriptor::setFieldArraySize(omnetpp::any_ptr object, int field, int size) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldArraySize(object, field, size);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    CollectTimer *pp = omnetpp::fromAnyPtr<CollectTimer>(object); (void)pp;
+    switch (field) {
+        default: throw omnetpp::cRuntimeError("Cannot set array size of field %d of class 'CollectTimer'", field);
+    }
+}
+
+const char *CollectTimerDescriptor::getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldDynamicTypeString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    CollectTimer *pp = omnetpp::fromAnyPtr<CollectTimer>(object); (void)pp;
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+std::string CollectTimerDescriptor::getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValueAsString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    CollectTimer *pp = omnetpp::fromAnyPtr<CollectTimer>(object); (void)pp;
+    switch (field) {
+        case FIELD_requestId: return long2string(pp->getRequestId());
+        default: return "";
+    }
+}
+
+void CollectTimerDescriptor::setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValueAsString(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    CollectTimer *pp = omnetpp::fromAnyPtr<CollectTimer>(object); (void)pp;
+    switch (field) {
+        case FIELD_requestId: pp->setRequestId(string2long(value)); break;
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'CollectTimer'", field);
+    }
+}
+
+omnetpp::cValue CollectTimerDescriptor::getFieldValue(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValue(object,field,i);
+        field -= base->getFieldCount();
+    }
+    CollectTimer *pp = omnetpp::fromAnyPtr<CollectTimer>(object); (void)pp;
+    switch (field) {
+        case FIELD_requestId: return (omnetpp::intval_t)(pp->getRequestId());
+        default: throw omnetpp::cRuntimeError("Cannot return field %d of class 'CollectTimer' as cValue -- field index out of range?", field);
+    }
+}
+
+void CollectTimerDescriptor::setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValue(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    CollectTimer *pp = omnetpp::fromAnyPtr<CollectTimer>(object); (void)pp;
+    switch (field) {
+        case FIELD_requestId: pp->setRequestId(omnetpp::checked_int_cast<long>(value.intValue())); break;
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'CollectTimer'", field);
+    }
+}
+
+const char *CollectTimerDescriptor::getFieldStructName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructName(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    };
+}
+
+omnetpp::any_ptr CollectTimerDescriptor::getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructValuePointer(object, field, i);
+        field -= base->getFieldCount();
+    }
+    CollectTimer *pp = omnetpp::fromAnyPtr<CollectTimer>(object); (void)pp;
+    switch (field) {
+        default: return omnetpp::any_ptr(nullptr);
+    }
+}
+
+void CollectTimerDescriptor::setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldStructValuePointer(object, field, i, ptr);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    CollectTimer *pp = omnetpp::fromAnyPtr<CollectTimer>(object); (void)pp;
+    switch (field) {
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'CollectTimer'", field);
+    }
+}
+
+Register_Class(FogSummary)
+
+FogSummary::FogSummary(const char *name, short kind) : ::garbage_collection::GarbagePacket(name, kind)
+{
+}
+
+FogSummary::FogSummary(const FogSummary& other) : ::garbage_collection::GarbagePacket(other)
+{
+    copy(other);
+}
+
+FogSummary::~FogSummary()
+{
+    delete [] this->statusCanIds;
+    delete [] this->statusFull;
+    delete [] this->collectCanIds;
+}
+
+FogSummary& FogSummary::operator=(const FogSummary& other)
+{
+    if (this == &other) return *this;
+    ::garbage_collection::GarbagePacket::operator=(other);
+    copy(other);
+    return *this;
+}
+
+void FogSummary::copy(const FogSummary& other)
+{
+    delete [] this->statusCanIds;
+    this->statusCanIds = (other.statusCanIds_arraysize==0) ? nullptr : new int[other.statusCanIds_arraysize];
+    statusCanIds_arraysize = other.statusCanIds_arraysize;
+    for (size_t i = 0; i < statusCanIds_arraysize; i++) {
+        this->statusCanIds[i] = other.statusCanIds[i];
+    }
+    delete [] this->statusFull;
+    this->statusFull = (other.statusFull_arraysize==0) ? nullptr : new bool[other.statusFull_arraysize];
+    statusFull_arraysize = other.statusFull_arraysize;
+    for (size_t i = 0; i < statusFull_arraysize; i++) {
+        this->statusFull[i] = other.statusFull[i];
+    }
+    delete [] this->collectCanIds;
+    this->collectCanIds = (other.collectCanIds_arraysize==0) ? nullptr : new int[other.collectCanIds_arraysize];
+    collectCanIds_arraysize = other.collectCanIds_arraysize;
+    for (size_t i = 0; i < collectCanIds_arraysize; i++) {
+        this->collectCanIds[i] = other.collectCanIds[i];
+    }
+}
+
+void FogSummary::parsimPack(omnetpp::cCommBuffer *b) const
+{
+    ::garbage_collection::GarbagePacket::parsimPack(b);
+    b->pack(statusCanIds_arraysize);
+    doParsimArrayPacking(b,this->statusCanIds,statusCanIds_arraysize);
+    b->pack(statusFull_arraysize);
+    doParsimArrayPacking(b,this->statusFull,statusFull_arraysize);
+    b->pack(collectCanIds_arraysize);
+    doParsimArrayPacking(b,this->collectCanIds,collectCanIds_arraysize);
+}
+
+void FogSummary::parsimUnpack(omnetpp::cCommBuffer *b)
+{
+    ::garbage_collection::GarbagePacket::parsimUnpack(b);
+    delete [] this->statusCanIds;
+    b->unpack(statusCanIds_arraysize);
+    if (statusCanIds_arraysize == 0) {
+        this->statusCanIds = nullptr;
+    } else {
+        this->statusCanIds = new int[statusCanIds_arraysize];
+        doParsimArrayUnpacking(b,this->statusCanIds,statusCanIds_arraysize);
+    }
+    delete [] this->statusFull;
+    b->unpack(statusFull_arraysize);
+    if (statusFull_arraysize == 0) {
+        this->statusFull = nullptr;
+    } else {
+        this->statusFull = new bool[statusFull_arraysize];
+        doParsimArrayUnpacking(b,this->statusFull,statusFull_arraysize);
+    }
+    delete [] this->collectCanIds;
+    b->unpack(collectCanIds_arraysize);
+    if (collectCanIds_arraysize == 0) {
+        this->collectCanIds = nullptr;
+    } else {
+        this->collectCanIds = new int[collectCanIds_arraysize];
+        doParsimArrayUnpacking(b,this->collectCanIds,collectCanIds_arraysize);
+    }
+}
+
+size_t FogSummary::getStatusCanIdsArraySize() const
+{
+    return statusCanIds_arraysize;
+}
+
+int FogSummary::getStatusCanIds(size_t k) const
+{
+    if (k >= statusCanIds_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)statusCanIds_arraysize, (unsigned long)k);
+    return this->statusCanIds[k];
+}
+
+void FogSummary::setStatusCanIdsArraySize(size_t newSize)
+{
+    int *statusCanIds2 = (newSize==0) ? nullptr : new int[newSize];
+    size_t minSize = statusCanIds_arraysize < newSize ? statusCanIds_arraysize : newSize;
+    for (size_t i = 0; i < minSize; i++)
+        statusCanIds2[i] = this->statusCanIds[i];
+    for (size_t i = minSize; i < newSize; i++)
+        statusCanIds2[i] = 0;
+    delete [] this->statusCanIds;
+    this->statusCanIds = statusCanIds2;
+    statusCanIds_arraysize = newSize;
+}
+
+void FogSummary::setStatusCanIds(size_t k, int statusCanIds)
+{
+    if (k >= statusCanIds_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)statusCanIds_arraysize, (unsigned long)k);
+    this->statusCanIds[k] = statusCanIds;
+}
+
+void FogSummary::insertStatusCanIds(size_t k, int statusCanIds)
+{
+    if (k > statusCanIds_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)statusCanIds_arraysize, (unsigned long)k);
+    size_t newSize = statusCanIds_arraysize + 1;
+    int *statusCanIds2 = new int[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        statusCanIds2[i] = this->statusCanIds[i];
+    statusCanIds2[k] = statusCanIds;
+    for (i = k + 1; i < newSize; i++)
+        statusCanIds2[i] = this->statusCanIds[i-1];
+    delete [] this->statusCanIds;
+    this->statusCanIds = statusCanIds2;
+    statusCanIds_arraysize = newSize;
+}
+
+void FogSummary::appendStatusCanIds(int statusCanIds)
+{
+    insertStatusCanIds(statusCanIds_arraysize, statusCanIds);
+}
+
+void FogSummary::eraseStatusCanIds(size_t k)
+{
+    if (k >= statusCanIds_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)statusCanIds_arraysize, (unsigned long)k);
+    size_t newSize = statusCanIds_arraysize - 1;
+    int *statusCanIds2 = (newSize == 0) ? nullptr : new int[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        statusCanIds2[i] = this->statusCanIds[i];
+    for (i = k; i < newSize; i++)
+        statusCanIds2[i] = this->statusCanIds[i+1];
+    delete [] this->statusCanIds;
+    this->statusCanIds = statusCanIds2;
+    statusCanIds_arraysize = newSize;
+}
+
+size_t FogSummary::getStatusFullArraySize() const
+{
+    return statusFull_arraysize;
+}
+
+bool FogSummary::getStatusFull(size_t k) const
+{
+    if (k >= statusFull_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)statusFull_arraysize, (unsigned long)k);
+    return this->statusFull[k];
+}
+
+void FogSummary::setStatusFullArraySize(size_t newSize)
+{
+    bool *statusFull2 = (newSize==0) ? nullptr : new bool[newSize];
+    size_t minSize = statusFull_arraysize < newSize ? statusFull_arraysize : newSize;
+    for (size_t i = 0; i < minSize; i++)
+        statusFull2[i] = this->statusFull[i];
+    for (size_t i = minSize; i < newSize; i++)
+        statusFull2[i] = false;
+    delete [] this->statusFull;
+    this->statusFull = statusFull2;
+    statusFull_arraysize = newSize;
+}
+
+void FogSummary::setStatusFull(size_t k, bool statusFull)
+{
+    if (k >= statusFull_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)statusFull_arraysize, (unsigned long)k);
+    this->statusFull[k] = statusFull;
+}
+
+void FogSummary::insertStatusFull(size_t k, bool statusFull)
+{
+    if (k > statusFull_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)statusFull_arraysize, (unsigned long)k);
+    size_t newSize = statusFull_arraysize + 1;
+    bool *statusFull2 = new bool[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        statusFull2[i] = this->statusFull[i];
+    statusFull2[k] = statusFull;
+    for (i = k + 1; i < newSize; i++)
+        statusFull2[i] = this->statusFull[i-1];
+    delete [] this->statusFull;
+    this->statusFull = statusFull2;
+    statusFull_arraysize = newSize;
+}
+
+void FogSummary::appendStatusFull(bool statusFull)
+{
+    insertStatusFull(statusFull_arraysize, statusFull);
+}
+
+void FogSummary::eraseStatusFull(size_t k)
+{
+    if (k >= statusFull_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)statusFull_arraysize, (unsigned long)k);
+    size_t newSize = statusFull_arraysize - 1;
+    bool *statusFull2 = (newSize == 0) ? nullptr : new bool[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        statusFull2[i] = this->statusFull[i];
+    for (i = k; i < newSize; i++)
+        statusFull2[i] = this->statusFull[i+1];
+    delete [] this->statusFull;
+    this->statusFull = statusFull2;
+    statusFull_arraysize = newSize;
+}
+
+size_t FogSummary::getCollectCanIdsArraySize() const
+{
+    return collectCanIds_arraysize;
+}
+
+int FogSummary::getCollectCanIds(size_t k) const
+{
+    if (k >= collectCanIds_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)collectCanIds_arraysize, (unsigned long)k);
+    return this->collectCanIds[k];
+}
+
+void FogSummary::setCollectCanIdsArraySize(size_t newSize)
+{
+    int *collectCanIds2 = (newSize==0) ? nullptr : new int[newSize];
+    size_t minSize = collectCanIds_arraysize < newSize ? collectCanIds_arraysize : newSize;
+    for (size_t i = 0; i < minSize; i++)
+        collectCanIds2[i] = this->collectCanIds[i];
+    for (size_t i = minSize; i < newSize; i++)
+        collectCanIds2[i] = 0;
+    delete [] this->collectCanIds;
+    this->collectCanIds = collectCanIds2;
+    collectCanIds_arraysize = newSize;
+}
+
+void FogSummary::setCollectCanIds(size_t k, int collectCanIds)
+{
+    if (k >= collectCanIds_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)collectCanIds_arraysize, (unsigned long)k);
+    this->collectCanIds[k] = collectCanIds;
+}
+
+void FogSummary::insertCollectCanIds(size_t k, int collectCanIds)
+{
+    if (k > collectCanIds_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)collectCanIds_arraysize, (unsigned long)k);
+    size_t newSize = collectCanIds_arraysize + 1;
+    int *collectCanIds2 = new int[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        collectCanIds2[i] = this->collectCanIds[i];
+    collectCanIds2[k] = collectCanIds;
+    for (i = k + 1; i < newSize; i++)
+        collectCanIds2[i] = this->collectCanIds[i-1];
+    delete [] this->collectCanIds;
+    this->collectCanIds = collectCanIds2;
+    collectCanIds_arraysize = newSize;
+}
+
+void FogSummary::appendCollectCanIds(int collectCanIds)
+{
+    insertCollectCanIds(collectCanIds_arraysize, collectCanIds);
+}
+
+void FogSummary::eraseCollectCanIds(size_t k)
+{
+    if (k >= collectCanIds_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)collectCanIds_arraysize, (unsigned long)k);
+    size_t newSize = collectCanIds_arraysize - 1;
+    int *collectCanIds2 = (newSize == 0) ? nullptr : new int[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        collectCanIds2[i] = this->collectCanIds[i];
+    for (i = k; i < newSize; i++)
+        collectCanIds2[i] = this->collectCanIds[i+1];
+    delete [] this->collectCanIds;
+    this->collectCanIds = collectCanIds2;
+    collectCanIds_arraysize = newSize;
+}
+
+class FogSummaryDescriptor : public omnetpp::cClassDescriptor
+{
+  private:
+    mutable const char **propertyNames;
+    enum FieldConstants {
+        FIELD_statusCanIds,
+        FIELD_statusFull,
+        FIELD_collectCanIds,
+    };
+  public:
+    FogSummaryDescriptor();
+    virtual ~FogSummaryDescriptor();
+
+    virtual bool doesSupport(omnetpp::cObject *obj) const override;
+    virtual const char **getPropertyNames() const override;
+    virtual const char *getProperty(const char *propertyName) const override;
+    virtual int getFieldCount() const override;
+    virtual const char *getFieldName(int field) const override;
+    virtual int findField(const char *fieldName) const override;
+    virtual unsigned int getFieldTypeFlags(int field) const override;
+    virtual const char *getFieldTypeString(int field) const override;
+    virtual const char **getFieldPropertyNames(int field) const override;
+    virtual const char *getFieldProperty(int field, const char *propertyName) const override;
+    virtual int getFieldArraySize(omnetpp::any_ptr object, int field) const override;
+    virtual void setFieldArraySize(omnetpp::any_ptr object, int field, int size) const override;
+
+    virtual const char *getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual std::string getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const override;
+    virtual omnetpp::cValue getFieldValue(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const override;
+
+    virtual const char *getFieldStructName(int field) const override;
+    virtual omnetpp::any_ptr getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const override;
+};
+
+Register_ClassDescriptor(FogSummaryDescriptor)
+
+FogSummaryDescriptor::FogSummaryDescriptor() : omnetpp::cClassDescriptor(omnetpp::opp_typename(typeid(garbage_collection::FogSummary)), "garbage_collection::GarbagePacket")
+{
+    propertyNames = nullptr;
+}
+
+FogSummaryDescriptor::~FogSummaryDescriptor()
+{
+    delete[] propertyNames;
+}
+
+bool FogSummaryDescriptor::doesSupport(omnetpp::cObject *obj) const
+{
+    return dynamic_cast<FogSummary *>(obj)!=nullptr;
+}
+
+const char **FogSummaryDescriptor::getPropertyNames() const
+{
+    if (!propertyNames) {
+        static const char *names[] = {  nullptr };
+        omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+        const char **baseNames = base ? base->getPropertyNames() : nullptr;
+        propertyNames = mergeLists(baseNames, names);
+    }
+    return propertyNames;
+}
+
+const char *FogSummaryDescriptor::getProperty(const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? base->getProperty(propertyName) : nullptr;
+}
+
+int FogSummaryDescriptor::getFieldCount() const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? 3+base->getFieldCount() : 3;
+}
+
+unsigned int FogSummaryDescriptor::getFieldTypeFlags(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeFlags(field);
+        field -= base->getFieldCount();
+    }
+    static unsigned int fieldTypeFlags[] = {
+        FD_ISARRAY | FD_ISEDITABLE | FD_ISRESIZABLE,    // FIELD_statusCanIds
+        FD_ISARRAY | FD_ISEDITABLE | FD_ISRESIZABLE,    // FIELD_statusFull
+        FD_ISARRAY | FD_ISEDITABLE | FD_ISRESIZABLE,    // FIELD_collectCanIds
+    };
+    return (field >= 0 && field < 3) ? fieldTypeFlags[field] : 0;
+}
+
+const char *FogSummaryDescriptor::getFieldName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldName(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldNames[] = {
+        "statusCanIds",
+        "statusFull",
+        "collectCanIds",
+    };
+    return (field >= 0 && field < 3) ? fieldNames[field] : nullptr;
+}
+
+int FogSummaryDescriptor::findField(const char *fieldName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    int baseIndex = base ? base->getFieldCount() : 0;
+    if (strcmp(fieldName, "statusCanIds") == 0) return baseIndex + 0;
+    if (strcmp(fieldName, "statusFull") == 0) return baseIndex + 1;
+    if (strcmp(fieldName, "collectCanIds") == 0) return baseIndex + 2;
+    return base ? base->findField(fieldName) : -1;
+}
+
+const char *FogSummaryDescriptor::getFieldTypeString(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeString(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldTypeStrings[] = {
+        "int",    // FIELD_statusCanIds
+        "bool",    // FIELD_statusFull
+        "int",    // FIELD_collectCanIds
+    };
+    return (field >= 0 && field < 3) ? fieldTypeStrings[field] : nullptr;
+}
+
+const char **FogSummaryDescriptor::getFieldPropertyNames(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldPropertyNames(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+const char *FogSummaryDescriptor::getFieldProperty(int field, const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldProperty(field, propertyName);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+int FogSummaryDescriptor::getFieldArraySize(omnetpp::any_ptr object, int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldArraySize(object, field);
+        field -= base->getFieldCount();
+    }
+    FogSummary *pp = omnetpp::fromAnyPtr<FogSummary>(object); (void)pp;
+    switch (field) {
+        case FIELD_statusCanIds: return pp->getStatusCanIdsArraySize();
+        case FIELD_statusFull: return pp->getStatusFullArraySize();
+        case FIELD_collectCanIds: return pp->getCollectCanIdsArraySize();
+        default: return 0;
+    }
+}
+
+void FogSummaryDescriptor::setFieldArraySize(omnetpp::any_ptr object, int field, int size) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldArraySize(object, field, size);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    FogSummary *pp = omnetpp::fromAnyPtr<FogSummary>(object); (void)pp;
+    switch (field) {
+        case FIELD_statusCanIds: pp->setStatusCanIdsArraySize(size); break;
+        case FIELD_statusFull: pp->setStatusFullArraySize(size); break;
+        case FIELD_collectCanIds: pp->setCollectCanIdsArraySize(size); break;
+        default: throw omnetpp::cRuntimeError("Cannot set array size of field %d of class 'FogSummary'", field);
+    }
+}
+
+const char *FogSummaryDescriptor::getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldDynamicTypeString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    FogSummary *pp = omnetpp::fromAnyPtr<FogSummary>(object); (void)pp;
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+std::string FogSummaryDescriptor::getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValueAsString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    FogSummary *pp = omnetpp::fromAnyPtr<FogSummary>(object); (void)pp;
+    switch (field) {
+        case FIELD_statusCanIds: return long2string(pp->getStatusCanIds(i));
+        case FIELD_statusFull: return bool2string(pp->getStatusFull(i));
+        case FIELD_collectCanIds: return long2string(pp->getCollectCanIds(i));
+        default: return "";
+    }
+}
+
+void FogSummaryDescriptor::setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValueAsString(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    FogSummary *pp = omnetpp::fromAnyPtr<FogSummary>(object); (void)pp;
+    switch (field) {
+        case FIELD_statusCanIds: pp->setStatusCanIds(i,string2long(value)); break;
+        case FIELD_statusFull: pp->setStatusFull(i,string2bool(value)); break;
+        case FIELD_collectCanIds: pp->setCollectCanIds(i,string2long(value)); break;
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'FogSummary'", field);
+    }
+}
+
+omnetpp::cValue FogSummaryDescriptor::getFieldValue(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValue(object,field,i);
+        field -= base->getFieldCount();
+    }
+    FogSummary *pp = omnetpp::fromAnyPtr<FogSummary>(object); (void)pp;
+    switch (field) {
+        case FIELD_statusCanIds: return pp->getStatusCanIds(i);
+        case FIELD_statusFull: return pp->getStatusFull(i);
+        case FIELD_collectCanIds: return pp->getCollectCanIds(i);
+        default: throw omnetpp::cRuntimeError("Cannot return field %d of class 'FogSummary' as cValue -- field index out of range?", field);
+    }
+}
+
+void FogSummaryDescriptor::setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValue(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    FogSummary *pp = omnetpp::fromAnyPtr<FogSummary>(object); (void)pp;
+    switch (field) {
+        case FIELD_statusCanIds: pp->setStatusCanIds(i,omnetpp::checked_int_cast<int>(value.intValue())); break;
+        case FIELD_statusFull: pp->setStatusFull(i,value.boolValue()); break;
+        case FIELD_collectCanIds: pp->setCollectCanIds(i,omnetpp::checked_int_cast<int>(value.intValue())); break;
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'FogSummary'", field);
+    }
+}
+
+const char *FogSummaryDescriptor::getFieldStructName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructName(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    };
+}
+
+omnetpp::any_ptr FogSummaryDescriptor::getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructValuePointer(object, field, i);
+        field -= base->getFieldCount();
+    }
+    FogSummary *pp = omnetpp::fromAnyPtr<FogSummary>(object); (void)pp;
+    switch (field) {
+        default: return omnetpp::any_ptr(nullptr);
+    }
+}
+
+void FogSummaryDescriptor::setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldStructValuePointer(object, field, i, ptr);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    FogSummary *pp = omnetpp::fromAnyPtr<FogSummary>(object); (void)pp;
+    switch (field) {
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'FogSummary'", field);
+    }
+}
+
+Register_Class(WorkSteal)
+
+WorkSteal::WorkSteal(const char *name, short kind) : ::garbage_collection::GarbagePacket(name, kind)
+{
+}
+
+WorkSteal::WorkSteal(const WorkSteal& other) : ::garbage_collection::GarbagePacket(other)
+{
+    copy(other);
+}
+
+WorkSteal::~WorkSteal()
+{
+    delete [] this->canIds;
+}
+
+WorkSteal& WorkSteal::operator=(const WorkSteal& other)
+{
+    if (this == &other) return *this;
+    ::garbage_collection::GarbagePacket::operator=(other);
+    copy(other);
+    return *this;
+}
+
+void WorkSteal::copy(const WorkSteal& other)
+{
+    this->hostIndex = other.hostIndex;
+    this->backlog = other.backlog;
+    this->idle = other.idle;
+    delete [] this->canIds;
+    this->canIds = (other.canIds_arraysize==0) ? nullptr : new int[other.canIds_arraysize];
+    canIds_arraysize = other.canIds_arraysize;
+    for (size_t i = 0; i < canIds_arraysize; i++) {
+        this->canIds[i] = other.canIds[i];
+    }
+}
+
+void WorkSteal::parsimPack(omnetpp::cCommBuffer *b) const
+{
+    ::garbage_collection::GarbagePacket::parsimPack(b);
+    doParsimPacking(b,this->hostIndex);
+    doParsimPacking(b,this->backlog);
+    doParsimPacking(b,this->idle);
+    b->pack(canIds_arraysize);
+    doParsimArrayPacking(b,this->canIds,canIds_arraysize);
+}
+
+void WorkSteal::parsimUnpack(omnetpp::cCommBuffer *b)
+{
+    ::garbage_collection::GarbagePacket::parsimUnpack(b);
+    doParsimUnpacking(b,this->hostIndex);
+    doParsimUnpacking(b,this->backlog);
+    doParsimUnpacking(b,this->idle);
+    delete [] this->canIds;
+    b->unpack(canIds_arraysize);
+    if (canIds_arraysize == 0) {
+        this->canIds = nullptr;
+    } else {
+        this->canIds = new int[canIds_arraysize];
+        doParsimArrayUnpacking(b,this->canIds,canIds_arraysize);
+    }
+}
+
+int WorkSteal::getHostIndex() const
+{
+    return this->hostIndex;
+}
+
+void WorkSteal::setHostIndex(int hostIndex)
+{
+    this->hostIndex = hostIndex;
+}
+
+int WorkSteal::getBacklog() const
+{
+    return this->backlog;
+}
+
+void WorkSteal::setBacklog(int backlog)
+{
+    this->backlog = backlog;
+}
+
+bool WorkSteal::isIdle() const
+{
+    return this->idle;
+}
+
+void WorkSteal::setIdle(bool idle)
+{
+    this->idle = idle;
+}
+
+size_t WorkSteal::getCanIdsArraySize() const
+{
+    return canIds_arraysize;
+}
+
+int WorkSteal::getCanIds(size_t k) const
+{
+    if (k >= canIds_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)canIds_arraysize, (unsigned long)k);
+    return this->canIds[k];
+}
+
+void WorkSteal::setCanIdsArraySize(size_t newSize)
+{
+    int *canIds2 = (newSize==0) ? nullptr : new int[newSize];
+    size_t minSize = canIds_arraysize < newSize ? canIds_arraysize : newSize;
+    for (size_t i = 0; i < minSize; i++)
+        canIds2[i] = this->canIds[i];
+    for (size_t i = minSize; i < newSize; i++)
+        canIds2[i] = 0;
+    delete [] this->canIds;
+    this->canIds = canIds2;
+    canIds_arraysize = newSize;
+}
+
+void WorkSteal::setCanIds(size_t k, int canIds)
+{
+    if (k >= canIds_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)canIds_arraysize, (unsigned long)k);
+    this->canIds[k] = canIds;
+}
+
+void WorkSteal::insertCanIds(size_t k, int canIds)
+{
+    if (k > canIds_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)canIds_arraysize, (unsigned long)k);
+    size_t newSize = canIds_arraysize + 1;
+    int *canIds2 = new int[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        canIds2[i] = this->canIds[i];
+    canIds2[k] = canIds;
+    for (i = k + 1; i < newSize; i++)
+        canIds2[i] = this->canIds[i-1];
+    delete [] this->canIds;
+    this->canIds = canIds2;
+    canIds_arraysize = newSize;
+}
+
+void WorkSteal::appendCanIds(int canIds)
+{
+    insertCanIds(canIds_arraysize, canIds);
+}
+
+void WorkSteal::eraseCanIds(size_t k)
+{
+    if (k >= canIds_arraysize) throw omnetpp::cRuntimeError("Array of size %lu accessed with index %lu", (unsigned long)canIds_arraysize, (unsigned long)k);
+    size_t newSize = canIds_arraysize - 1;
+    int *canIds2 = (newSize == 0) ? nullptr : new int[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        canIds2[i] = this->canIds[i];
+    for (i = k; i < newSize; i++)
+        canIds2[i] = this->canIds[i+1];
+    delete [] this->canIds;
+    this->canIds = canIds2;
+    canIds_arraysize = newSize;
+}
+
+class WorkStealDescriptor : public omnetpp::cClassDescriptor
+{
+  private:
+    mutable const char **propertyNames;
+    enum FieldConstants {
+        FIELD_hostIndex,
+        FIELD_backlog,
+        FIELD_idle,
+        FIELD_canIds,
+    };
+  public:
+    WorkStealDescriptor();
+    virtual ~WorkStealDescriptor();
+
+    virtual bool doesSupport(omnetpp::cObject *obj) const override;
+    virtual const char **getPropertyNames() const override;
+    virtual const char *getProperty(const char *propertyName) const override;
+    virtual int getFieldCount() const override;
+    virtual const char *getFieldName(int field) const override;
+    virtual int findField(const char *fieldName) const override;
+    virtual unsigned int getFieldTypeFlags(int field) const override;
+    virtual const char *getFieldTypeString(int field) const override;
+    virtual const char **getFieldPropertyNames(int field) const override;
+    virtual const char *getFieldProperty(int field, const char *propertyName) const override;
+    virtual int getFieldArraySize(omnetpp::any_ptr object, int field) const override;
+    virtual void setFieldArraySize(omnetpp::any_ptr object, int field, int size) const override;
+
+    virtual const char *getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual std::string getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const override;
+    virtual omnetpp::cValue getFieldValue(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const override;
+
+    virtual const char *getFieldStructName(int field) const override;
+    virtual omnetpp::any_ptr getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const override;
+};
+
+Register_ClassDescriptor(WorkStealDescriptor)
+
+WorkStealDescriptor::WorkStealDescriptor() : omnetpp::cClassDescriptor(omnetpp::opp_typename(typeid(garbage_collection::WorkSteal)), "garbage_collection::GarbagePacket")
+{
+    propertyNames = nullptr;
+}
+
+WorkStealDescriptor::~WorkStealDescriptor()
+{
+    delete[] propertyNames;
+}
+
+bool WorkStealDescriptor::doesSupport(omnetpp::cObject *obj) const
+{
+    return dynamic_cast<WorkSteal *>(obj)!=nullptr;
+}
+
+const char **WorkStealDescriptor::getPropertyNames() const
+{
+    if (!propertyNames) {
+        static const char *names[] = {  nullptr };
+        omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+        const char **baseNames = base ? base->getPropertyNames() : nullptr;
+        propertyNames = mergeLists(baseNames, names);
+    }
+    return propertyNames;
+}
+
+const char *WorkStealDescriptor::getProperty(const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? base->getProperty(propertyName) : nullptr;
+}
+
+int WorkStealDescriptor::getFieldCount() const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? 4+base->getFieldCount() : 4;
+}
+
+unsigned int WorkStealDescriptor::getFieldTypeFlags(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeFlags(field);
+        field -= base->getFieldCount();
+    }
+    static unsigned int fieldTypeFlags[] = {
+        FD_ISEDITABLE,    // FIELD_hostIndex
+        FD_ISEDITABLE,    // FIELD_backlog
+        FD_ISEDITABLE,    // FIELD_idle
+        FD_ISARRAY | FD_ISEDITABLE | FD_ISRESIZABLE,    // FIELD_canIds
+    };
+    return (field >= 0 && field < 4) ? fieldTypeFlags[field] : 0;
+}
+
+const char *WorkStealDescriptor::getFieldName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldName(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldNames[] = {
+        "hostIndex",
+        "backlog",
+        "idle",
+        "canIds",
+    };
+    return (field >= 0 && field < 4) ? fieldNames[field] : nullptr;
+}
+
+int WorkStealDescriptor::findField(const char *fieldName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    int baseIndex = base ? base->getFieldCount() : 0;
+    if (strcmp(fieldName, "hostIndex") == 0) return baseIndex + 0;
+    if (strcmp(fieldName, "backlog") == 0) return baseIndex + 1;
+    if (strcmp(fieldName, "idle") == 0) return baseIndex + 2;
+    if (strcmp(fieldName, "canIds") == 0) return baseIndex + 3;
+    return base ? base->findField(fieldName) : -1;
+}
+
+const char *WorkStealDescriptor::getFieldTypeString(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeString(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldTypeStrings[] = {
+        "int",    // FIELD_hostIndex
+        "int",    // FIELD_backlog
+        "bool",    // FIELD_idle
+        "int",    // FIELD_canIds
+    };
+    return (field >= 0 && field < 4) ? fieldTypeStrings[field] : nullptr;
+}
+
+const char **WorkStealDescriptor::getFieldPropertyNames(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldPropertyNames(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+const char *WorkStealDescriptor::getFieldProperty(int field, const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldProperty(field, propertyName);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+int WorkStealDescriptor::getFieldArraySize(omnetpp::any_ptr object, int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldArraySize(object, field);
+        field -= base->getFieldCount();
+    }
+    WorkSteal *pp = omnetpp::fromAnyPtr<WorkSteal>(object); (void)pp;
+    switch (field) {
+        case FIELD_canIds: return pp->getCanIdsArraySize();
+        default: return 0;
+    }
+}
+
+void WorkStealDescriptor::setFieldArraySize(omnetpp::any_ptr object, int field, int size) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldArraySize(object, field, size);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    WorkSteal *pp = omnetpp::fromAnyPtr<WorkSteal>(object); (void)pp;
+    switch (field) {
+        case FIELD_canIds: pp->setCanIdsArraySize(size); break;
+        default: throw omnetpp::cRuntimeError("Cannot set array size of field %d of class 'WorkSteal'", field);
+    }
+}
+
+const char *WorkStealDescriptor::getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldDynamicTypeString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    WorkSteal *pp = omnetpp::fromAnyPtr<WorkSteal>(object); (void)pp;
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+std::string WorkStealDescriptor::getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValueAsString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    WorkSteal *pp = omnetpp::fromAnyPtr<WorkSteal>(object); (void)pp;
+    switch (field) {
+        case FIELD_hostIndex: return long2string(pp->getHostIndex());
+        case FIELD_backlog: return long2string(pp->getBacklog());
+        case FIELD_idle: return bool2string(pp->isIdle());
+        case FIELD_canIds: return long2string(pp->getCanIds(i));
+        default: return "";
+    }
+}
+
+void WorkStealDescriptor::setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValueAsString(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    WorkSteal *pp = omnetpp::fromAnyPtr<WorkSteal>(object); (void)pp;
+    switch (field) {
+        case FIELD_hostIndex: pp->setHostIndex(string2long(value)); break;
+        case FIELD_backlog: pp->setBacklog(string2long(value)); break;
+        case FIELD_idle: pp->setIdle(string2bool(value)); break;
+        case FIELD_canIds: pp->setCanIds(i,string2long(value)); break;
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'WorkSteal'", field);
+    }
+}
+
+omnetpp::cValue WorkStealDescriptor::getFieldValue(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValue(object,field,i);
+        field -= base->getFieldCount();
+    }
+    WorkSteal *pp = omnetpp::fromAnyPtr<WorkSteal>(object); (void)pp;
+    switch (field) {
+        case FIELD_hostIndex: return pp->getHostIndex();
+        case FIELD_backlog: return pp->getBacklog();
+        case FIELD_idle: return pp->isIdle();
+        case FIELD_canIds: return pp->getCanIds(i);
+        default: throw omnetpp::cRuntimeError("Cannot return field %d of class 'WorkSteal' as cValue -- field index out of range?", field);
+    }
+}
+
+void WorkStealDescriptor::setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValue(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    WorkSteal *pp = omnetpp::fromAnyPtr<WorkSteal>(object); (void)pp;
+    switch (field) {
+        case FIELD_hostIndex: pp->setHostIndex(omnetpp::checked_int_cast<int>(value.intValue())); break;
+        case FIELD_backlog: pp->setBacklog(omnetpp::checked_int_cast<int>(value.intValue())); break;
+        case FIELD_idle: pp->setIdle(value.boolValue()); break;
+        case FIELD_canIds: pp->setCanIds(i,omnetpp::checked_int_cast<int>(value.intValue())); break;
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'WorkSteal'", field);
+    }
+}
+
+const char *WorkStealDescriptor::getFieldStructName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructName(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    };
+}
+
+omnetpp::any_ptr WorkStealDescriptor::getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructValuePointer(object, field, i);
+        field -= base->getFieldCount();
+    }
+    WorkSteal *pp = omnetpp::fromAnyPtr<WorkSteal>(object); (void)pp;
+    switch (field) {
+        default: return omnetpp::any_ptr(nullptr);
+    }
+}
+
+void WorkStealDescriptor::setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldStructValuePointer(object, field, i, ptr);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    WorkSteal *pp = omnetpp::fromAnyPtr<WorkSteal>(object); (void)pp;
+    switch (field) {
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'WorkSteal'", field);
+    }
+}
+
+Register_Enum(garbage_collection::CloudPort, (garbage_collection::CloudPort::PORT_NONE, garbage_collection::CloudPort::PORT_HOST, garbage_collection::CloudPort::PORT_CAN, garbage_collection::CloudPort::PORT_FOG));
+
+Register_Class(ShardEnvelope)
+
+ShardEnvelope::ShardEnvelope(const char *name, short kind) : ::garbage_collection::GarbagePacket(name, kind)
+{
+}
+
+ShardEnvelope::ShardEnvelope(const ShardEnvelope& other) : ::garbage_collection::GarbagePacket(other)
+{
+    copy(other);
+}
+
+ShardEnvelope::~ShardEnvelope()
+{
+}
+
+ShardEnvelope& ShardEnvelope::operator=(const ShardEnvelope& other)
+{
+    if (this == &other) return *this;
+    ::garbage_collection::GarbagePacket::operator=(other);
+    copy(other);
+    return *this;
+}
+
+void ShardEnvelope::copy(const ShardEnvelope& other)
+{
+    this->port = other.port;
+    this->portIndex = other.portIndex;
+}
+
+void ShardEnvelope::parsimPack(omnetpp::cCommBuffer *b) const
+{
+    ::garbage_collection::GarbagePacket::parsimPack(b);
+    doParsimPacking(b,this->port);
+    doParsimPacking(b,this->portIndex);
+}
+
+void ShardEnvelope::parsimUnpack(omnetpp::cCommBuffer *b)
+{
+    ::garbage_collection::GarbagePacket::parsimUnpack(b);
+    doParsimUnpacking(b,this->port);
+    doParsimUnpacking(b,this->portIndex);
+}
+
+int ShardEnvelope::getPort() const
+{
+    return this->port;
+}
+
+void ShardEnvelope::setPort(int port)
+{
+    this->port = port;
+}
+
+int ShardEnvelope::getPortIndex() const
+{
+    return this->portIndex;
+}
+
+void ShardEnvelope::setPortIndex(int portIndex)
+{
+    this->portIndex = portIndex;
+}
+class ShardEnvelopeDescriptor : public omnetpp::cClassDescriptor
+{
+  private:
+    mutable const char **propertyNames;
+    enum FieldConstants {
+        FIELD_port,
+        FIELD_portIndex,
+    };
+  public:
+    ShardEnvelopeDescriptor();
+    virtual ~ShardEnvelopeDescriptor();
+
+    virtual bool doesSupport(omnetpp::cObject *obj) const override;
+    virtual const char **getPropertyNames() const override;
+    virtual const char *getProperty(const char *propertyName) const override;
+    virtual int getFieldCount() const override;
+    virtual const char *getFieldName(int field) const override;
+    virtual int findField(const char *fieldName) const override;
+    virtual unsigned int getFieldTypeFlags(int field) const override;
+    virtual const char *getFieldTypeString(int field) const override;
+    virtual const char **getFieldPropertyNames(int field) const override;
+    virtual const char *getFieldProperty(int field, const char *propertyName) const override;
+    virtual int getFieldArraySize(omnetpp::any_ptr object, int field) const override;
+    virtual void setFieldArraySize(omnetpp::any_ptr object, int field, int size) const override;
+
+    virtual const char *getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual std::string getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const override;
+    virtual omnetpp::cValue getFieldValue(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const override;
+
+    virtual const char *getFieldStructName(int field) const override;
+    virtual omnetpp::any_ptr getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const override;
+};
+
+Register_ClassDescriptor(ShardEnvelopeDescriptor)
+
+ShardEnvelopeDescriptor::ShardEnvelopeDescriptor() : omnetpp::cClassDescriptor(omnetpp::opp_typename(typeid(garbage_collection::ShardEnvelope)), "garbage_collection::GarbagePacket")
+{
+    propertyNames = nullptr;
+}
+
+ShardEnvelopeDescriptor::~ShardEnvelopeDescriptor()
+{
+    delete[] propertyNames;
+}
+
+bool ShardEnvelopeDescriptor::doesSupport(omnetpp::cObject *obj) const
+{
+    return dynamic_cast<ShardEnvelope *>(obj)!=nullptr;
+}
+
+const char **ShardEnvelopeDescriptor::getPropertyNames() const
+{
+    if (!propertyNames) {
+        static const char *names[] = {  nullptr };
+        omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+        const char **baseNames = base ? base->getPropertyNames() : nullptr;
+        propertyNames = mergeLists(baseNames, names);
+    }
+    return propertyNames;
+}
+
+const char *ShardEnvelopeDescriptor::getProperty(const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? base->getProperty(propertyName) : nullptr;
+}
+
+int ShardEnvelopeDescriptor::getFieldCount() const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? 2+base->getFieldCount() : 2;
+}
+
+unsigned int ShardEnvelopeDescriptor::getFieldTypeFlags(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeFlags(field);
+        field -= base->getFieldCount();
+    }
+    static unsigned int fieldTypeFlags[] = {
+        FD_ISEDITABLE,    // FIELD_port
+        FD_ISEDITABLE,    // FIELD_portIndex
+    };
+    return (field >= 0 && field < 2) ? fieldTypeFlags[field] : 0;
+}
+
+const char *ShardEnvelopeDescriptor::getFieldName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldName(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldNames[] = {
+        "port",
+        "portIndex",
+    };
+    return (field >= 0 && field < 2) ? fieldNames[field] : nullptr;
+}
+
+int ShardEnvelopeDescriptor::findField(const char *fieldName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    int baseIndex = base ? base->getFieldCount() : 0;
+    if (strcmp(fieldName, "port") == 0) return baseIndex + 0;
+    if (strcmp(fieldName, "portIndex") == 0) return baseIndex + 1;
+    return base ? base->findField(fieldName) : -1;
+}
+
+const char *ShardEnvelopeDescriptor::getFieldTypeString(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeString(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldTypeStrings[] = {
+        "int",    // FIELD_port
+        "int",    // FIELD_portIndex
+    };
+    return (field >= 0 && field < 2) ? fieldTypeStrings[field] : nullptr;
+}
+
+const char **ShardEnvelopeDescriptor::getFieldPropertyNames(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldPropertyNames(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+const char *ShardEnvelopeDescriptor::getFieldProperty(int field, const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldProperty(field, propertyName);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+int ShardEnvelopeDescriptor::getFieldArraySize(omnetpp::any_ptr object, int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldArraySize(object, field);
+        field -= base->getFieldCount();
+    }
+    ShardEnvelope *pp = omnetpp::fromAnyPtr<ShardEnvelope>(object); (void)pp;
+    switch (field) {
+        default: return 0;
+    }
+}
+
+void ShardEnvelopeDescriptor::setFieldArraySize(omnetpp::any_ptr object, int field, int size) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldArraySize(object, field, size);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    ShardEnvelope *pp = omnetpp::fromAnyPtr<ShardEnvelope>(object); (void)pp;
+    switch (field) {
+        default: throw omnetpp::cRuntimeError("Cannot set array size of field %d of class 'ShardEnvelope'", field);
+    }
+}
+
+const char *ShardEnvelopeDescriptor::getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldDynamicTypeString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    ShardEnvelope *pp = omnetpp::fromAnyPtr<ShardEnvelope>(object); (void)pp;
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+std::string ShardEnvelopeDescriptor::getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValueAsString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    ShardEnvelope *pp = omnetpp::fromAnyPtr<ShardEnvelope>(object); (void)pp;
+    switch (field) {
+        case FIELD_port: return long2string(pp->getPort());
+        case FIELD_portIndex: return long2string(pp->getPortIndex());
+        default: return "";
+    }
+}
+
+void ShardEnvelopeDescriptor::setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValueAsString(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    ShardEnvelope *pp = omnetpp::fromAnyPtr<ShardEnvelope>(object); (void)pp;
+    switch (field) {
+        case FIELD_port: pp->setPort(string2long(value)); break;
+        case FIELD_portIndex: pp->setPortIndex(string2long(value)); break;
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'ShardEnvelope'", field);
+    }
+}
+
+omnetpp::cValue ShardEnvelopeDescriptor::getFieldValue(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValue(object,field,i);
+        field -= base->getFieldCount();
+    }
+    ShardEnvelope *pp = omnetpp::fromAnyPtr<ShardEnvelope>(object); (void)pp;
+    switch (field) {
+        case FIELD_port: return pp->getPort();
+        case FIELD_portIndex: return pp->getPortIndex();
+        default: throw omnetpp::cRuntimeError("Cannot return field %d of class 'ShardEnvelope' as cValue -- field index out of range?", field);
+    }
+}
+
+void ShardEnvelopeDescriptor::setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValue(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    ShardEnvelope *pp = omnetpp::fromAnyPtr<ShardEnvelope>(object); (void)pp;
+    switch (field) {
+        case FIELD_port: pp->setPort(omnetpp::checked_int_cast<int>(value.intValue())); break;
+        case FIELD_portIndex: pp->setPortIndex(omnetpp::checked_int_cast<int>(value.intValue())); break;
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'ShardEnvelope'", field);
+    }
+}
+
+const char *ShardEnvelopeDescriptor::getFieldStructName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructName(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    };
+}
+
+omnetpp::any_ptr ShardEnvelopeDescriptor::getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructValuePointer(object, field, i);
+        field -= base->getFieldCount();
+    }
+    ShardEnvelope *pp = omnetpp::fromAnyPtr<ShardEnvelope>(object); (void)pp;
+    switch (field) {
+        default: return omnetpp::any_ptr(nullptr);
+    }
+}
+
+void ShardEnvelopeDescriptor::setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldStructValuePointer(object, field, i, ptr);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    ShardEnvelope *pp = omnetpp::fromAnyPtr<ShardEnvelope>(object); (void)pp;
+    switch (field) {
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'ShardEnvelope'", field);
+    }
+}
+
 }  // namespace garbage_collection
 
 namespace omnetpp {
@@ -20,6 +20,11 @@
 namespace garbage_collection {
 
 class GarbagePacket;
+class CanTimer;
+class CollectTimer;
+class FogSummary;
+class WorkSteal;
+class ShardEnvelope;
 
 }  // namespace garbage_collection
 
@@ -27,26 +32,82 @@ class GarbagePacket;
 namespace garbage_collection {
 
 /**
- * Class generated from <tt>garbage_collection/messages.msg:4</tt> by opp_msgtool.
+ * Enum generated from <tt>garbage_collection/messages.msg:7</tt> by opp_msgtool.
+ * <pre>
+ * enum GarbageOpcode
+ * {
+ *     OP_NONE = 0;
+ *     OP_QUERY = 1;
+ *     OP_STATUS_NO = 2;
+ *     OP_STATUS_YES = 3;
+ *     OP_COLLECT = 4;
+ *     OP_COLLECT_ACK = 5;
+ *     OP_CLOUD_ACK = 6;
+ *     OP_NOTIFY = 7;      // push mode: the can's fill state changed
+ *     OP_NOTIFY_ACK = 8;
+ *     OP_HEARTBEAT = 9;   // push mode: periodic liveness report carrying the fill state
+ *     OP_SUMMARY = 10;    // fog aggregator batch, see FogSummary
+ *     OP_SUMMARY_ACK = 11;
+ *     OP_LOAD_REPORT = 12; // work stealing, see WorkSteal
+ *     OP_STEAL_ORDER = 13;
+ *     OP_STEAL_GRANT = 14;
+ *     OP_SHARD_HANDOFF = 15; // cloud shards: cans moving between shards, as a FogSummary
+ *     OP_CLOUD_BUSY = 16;  // cloud queue full: retry after travelTime; the rejected packet is encapsulated
+ *     OP_BACKPRESSURE = 17; // cloud queue long: send less for travelTime
+ *     OP_COUNT = 18;      // number of opcodes; keep last when adding new ones
+ * }
+ * </pre>
+ */
+enum GarbageOpcode {
+    OP_NONE = 0,
+    OP_QUERY = 1,
+    OP_STATUS_NO = 2,
+    OP_STATUS_YES = 3,
+    OP_COLLECT = 4,
+    OP_COLLECT_ACK = 5,
+    OP_CLOUD_ACK = 6,
+    OP_NOTIFY = 7,
+    OP_NOTIFY_ACK = 8,
+    OP_HEARTBEAT = 9,
+    OP_SUMMARY = 10,
+    OP_SUMMARY_ACK = 11,
+    OP_LOAD_REPORT = 12,
+    OP_STEAL_ORDER = 13,
+    OP_STEAL_GRANT = 14,
+    OP_SHARD_HANDOFF = 15,
+    OP_CLOUD_BUSY = 16,
+    OP_BACKPRESSURE = 17,
+    OP_COUNT = 18
+};
+
+inline void doParsimPacking(omnetpp::cCommBuffer *b, const GarbageOpcode& e) { b->pack(static_cast<int>(e)); }
+inline void doParsimUnpacking(omnetpp::cCommBuffer *b, GarbageOpcode& e) { int n; b->unpack(n); e = static_cast<GarbageOpcode>(n); }
+
+/**
+ * Class generated from <tt>garbage_collection/messages.msg:30</tt> by opp_msgtool.
  * <pre>
  * packet GarbagePacket
  * {
- *     string command;
+ *     GarbageOpcode opcode = OP_NONE;
  *     int canId = -1;
  *     bool isFull = false;
  *     double travelTime = 0;
  *     string note;
+ *     long requestId = -1;    // collect request id or notification sequence number, echoed in the ack
+ *     int attempt = 0;        // query attempt number, echoed by the can in its status
  * }
  * </pre>
  */
 class GarbagePacket : public ::omnetpp::cPacket
 {
   protected:
-    ::omnetpp::opp_string command;
+    GarbageOpcode opcode = OP_NONE;
     int canId = -1;
     bool isFull_ = false;
     double travelTime = 0;
     ::omnetpp::opp_string note;
+    long requestId = -1;
+    int attempt = 0;
 
   private:
     void copy(const GarbagePacket& other);
@@ -63,8 +124,8 @@ class GarbagePacket : public ::omnetpp::cPacket
     virtual void parsimPack(omnetpp::cCommBuffer *b) const override;
     virtual void parsimUnpack(omnetpp::cCommBuffer *b) override;
 
-    virtual const char * getCommand() const;
-    virtual void setCommand(const char * command);
+    virtual GarbageOpcode getOpcode() const;
+    virtual void setOpcode(GarbageOpcode opcode);
 
     virtual int getCanId() const;
     virtual void setCanId(int canId);
@@ -77,11 +138,290 @@ class GarbagePacket : public ::omnetpp::cPacket
 
     virtual const char * getNote() const;
     virtual void setNote(const char * note);
+
+    virtual long getRequestId() const;
+    virtual void setRequestId(long requestId);
+
+    virtual int getAttempt() const;
+    virtual void setAttempt(int attempt);
 };
 
 inline void doParsimPacking(omnetpp::cCommBuffer *b, const GarbagePacket& obj) {obj.parsimPack(b);}
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, GarbagePacket& obj) {obj.parsimUnpack(b);}
 
+/**
+ * Class generated from <tt>garbage_collection/messages.msg:43</tt> by opp_msgtool.
+ * <pre>
+ * message CanTimer
+ * {
+ *     int canId = -1;
+ * }
+ * </pre>
+ */
+class CanTimer : public ::omnetpp::cMessage
+{
+  protected:
+    int canId = -1;
+
+  private:
+    void copy(const CanTimer& other);
+
+  protected:
+    bool operator==(const CanTimer&) = delete;
+
+  public:
+    CanTimer(const char *name=nullptr, short kind=0);
+    CanTimer(const CanTimer& other);
+    virtual ~CanTimer();
+    CanTimer& operator=(const CanTimer& other);
+    virtual CanTimer *dup() const override {return new CanTimer(*this);}
+    virtual void parsimPack(omnetpp::cCommBuffer *b) const override;
+    virtual void parsimUnpack(omnetpp::cCommBuffer *b) override;
+
+    virtual int getCanId() const;
+    virtual void setCanId(int canId);
+};
+
+inline void doParsimPacking(omnetpp::cCommBuffer *b, const CanTimer& obj) {obj.parsimPack(b);}
+inline void doParsimUnpacking(omnetpp::cCommBuffer *b, CanTimer& obj) {obj.parsimUnpack(b);}
+
+/**
+ * Class generated from <tt>garbage_collection/messages.msg:49</tt> by opp_msgtool.
+ * <pre>
+ * message CollectTimer
+ * {
+ *     long requestId = -1;
+ * }
+ * </pre>
+ */
+class CollectTimer : public ::omnetpp::cMessage
+{
+  protected:
+    long requestId = -1;
+
+  private:
+    void copy(const CollectTimer& other);
+
+  protected:
+    bool operator==(const CollectTimer&) = delete;
+
+  public:
+    CollectTimer(const char *name=nullptr, short kind=0);
+    CollectTimer(const CollectTimer& other);
+    virtual ~CollectTimer();
+    CollectTimer& operator=(const CollectTimer& other);
+    virtual CollectTimer *dup() const override {return new CollectTimer(*this);}
+    virtual void parsimPack(omnetpp::cCommBuffer *b) const override;
+    virtual void parsimUnpack(omnetpp::cCommBuffer *b) override;
+
+    virtual long getRequestId() const;
+    virtual void setRequestId(long requestId);
+};
+
+inline void doParsimPacking(omnetpp::cCommBuffer *b, const CollectTimer& obj) {obj.parsimPack(b);}
+inline void doParsimUnpacking(omnetpp::cCommBuffer *b, CollectTimer& obj) {obj.parsimUnpack(b);}
+
+/**
+ * Class generated from <tt>garbage_collection/messages.msg:57</tt> by opp_msgtool.
+ * <pre>
+ * // Batch forwarded by a fog aggregator: the latest state of every can that
+ * // reported since the last flush, and the cans that asked for a collect. The
+ * // cloud answers with an OP_SUMMARY_ACK listing the collects it confirmed.
+ * packet FogSummary extends GarbagePacket
+ * {
+ *     int statusCanIds[];
+ *     bool statusFull[];      // parallel to statusCanIds
+ *     int collectCanIds[];
+ * }
+ * </pre>
+ */
+class FogSummary : public ::garbage_collection::GarbagePacket
+{
+  protected:
+    int *statusCanIds = nullptr;
+    size_t statusCanIds_arraysize = 0;
+    bool *statusFull = nullptr;
+    size_t statusFull_arraysize = 0;
+    int *collectCanIds = nullptr;
+    size_t collectCanIds_arraysize = 0;
+
+  private:
+    void copy(const FogSummary& other);
+
+  protected:
+    bool operator==(const FogSummary&) = delete;
+
+  public:
+    FogSummary(const char *name=nullptr, short kind=0);
+    FogSummary(const FogSummary& other);
+    virtual ~FogSummary();
+    FogSummary& operator=(const FogSummary& other);
+    virtual FogSummary *dup() const override {return new FogSummary(*this);}
+    virtual void parsimPack(omnetpp::cCommBuffer *b) const override;
+    virtual void parsimUnpack(omnetpp::cCommBuffer *b) override;
+
+    virtual void setStatusCanIdsArraySize(size_t size);
+    virtual size_t getStatusCanIdsArraySize() const;
+    virtual int getStatusCanIds(size_t k) const;
+    virtual void setStatusCanIds(size_t k, int statusCanIds);
+    virtual void insertStatusCanIds(size_t k, int statusCanIds);
+    [[deprecated]] void insertStatusCanIds(int statusCanIds) {appendStatusCanIds(statusCanIds);}
+    virtual void appendStatusCanIds(int statusCanIds);
+    virtual void eraseStatusCanIds(size_t k);
+
+    virtual void setStatusFullArraySize(size_t size);
+    virtual size_t getStatusFullArraySize() const;
+    virtual bool getStatusFull(size_t k) const;
+    virtual void setStatusFull(size_t k, bool statusFull);
+    virtual void insertStatusFull(size_t k, bool statusFull);
+    [[deprecated]] void insertStatusFull(bool statusFull) {appendStatusFull(statusFull);}
+    virtual void appendStatusFull(bool statusFull);
+    virtual void eraseStatusFull(size_t k);
+
+    virtual void setCollectCanIdsArraySize(size_t size);
+    virtual size_t getCollectCanIdsArraySize() const;
+    virtual int getCollectCanIds(size_t k) const;
+    virtual void setCollectCanIds(size_t k, int collectCanIds);
+    virtual void insertCollectCanIds(size_t k, int collectCanIds);
+    [[deprecated]] void insertCollectCanIds(int collectCanIds) {appendCollectCanIds(collectCanIds);}
+    virtual void appendCollectCanIds(int collectCanIds);
+    virtual void eraseCollectCanIds(size_t k);
+};
+
+inline void doParsimPacking(omnetpp::cCommBuffer *b, const FogSummary& obj) {obj.parsimPack(b);}
+inline void doParsimUnpacking(omnetpp::cCommBuffer *b, FogSummary& obj) {obj.parsimUnpack(b);}
+
+/**
+ * Class generated from <tt>garbage_collection/messages.msg:70</tt> by opp_msgtool.
+ * <pre>
+ * // Work stealing between collectors, relayed by the cloud. OP_LOAD_REPORT: the
+ * // collector hostIndex has backlog cans another collector may take over, and is
+ * // idle once its own round is resolved. OP_STEAL_ORDER: the cloud asks a
+ * // collector to hand up to backlog cans to collector hostIndex. OP_STEAL_GRANT:
+ * // the canIds handed over, with the giver's remaining backlog; hostIndex is the
+ * // receiving collector on the way to the cloud and the giving one after it.
+ * packet WorkSteal extends GarbagePacket
+ * {
+ *     int hostIndex = -1;
+ *     int backlog = 0;
+ *     bool idle = false;
+ *     int canIds[];
+ * }
+ * </pre>
+ */
+class WorkSteal : public ::garbage_collection::GarbagePacket
+{
+  protected:
+    int hostIndex = -1;
+    int backlog = 0;
+    bool idle = false;
+    int *canIds = nullptr;
+    size_t canIds_arraysize = 0;
+
+  private:
+    void copy(const WorkSteal& other);
+
+  protected:
+    bool operator==(const WorkSteal&) = delete;
+
+  public:
+    WorkSteal(const char *name=nullptr, short kind=0);
+    WorkSteal(const WorkSteal& other);
+    virtual ~WorkSteal();
+    WorkSteal& operator=(const WorkSteal& other);
+    virtual WorkSteal *dup() const override {return new WorkSteal(*this);}
+    virtual void parsimPack(omnetpp::cCommBuffer *b) const override;
+    virtual void parsimUnpack(omnetpp::cCommBuffer *b) override;
+
+    virtual int getHostIndex() const;
+    virtual void setHostIndex(int hostIndex);
+
+    virtual int getBacklog() const;
+    virtual void setBacklog(int backlog);
+
+    virtual bool isIdle() const;
+    virtual void setIdle(bool idle);
+
+    virtual void setCanIdsArraySize(size_t size);
+    virtual size_t getCanIdsArraySize() const;
+    virtual int getCanIds(size_t k) const;
+    virtual void setCanIds(size_t k, int canIds);
+    virtual void insertCanIds(size_t k, int canIds);
+    [[deprecated]] void insertCanIds(int canIds) {appendCanIds(canIds);}
+    virtual void appendCanIds(int canIds);
+    virtual void eraseCanIds(size_t k);
+};
+
+inline void doParsimPacking(omnetpp::cCommBuffer *b, const WorkSteal& obj) {obj.parsimPack(b);}
+inline void doParsimUnpacking(omnetpp::cCommBuffer *b, WorkSteal& obj) {obj.parsimUnpack(b);}
+
+/**
+ * Enum generated from <tt>garbage_collection/messages.msg:79</tt> by opp_msgtool.
+ * <pre>
+ * // Which of the cloud's gate vectors a packet entered or leaves by.
+ * enum CloudPort
+ * {
+ *     PORT_NONE = 0;
+ *     PORT_HOST = 1;      // inHost/outHost, indexed by collector
+ *     PORT_CAN = 2;       // inCan/outCan, indexed by can id
+ *     PORT_FOG = 3;       // inFog/outFog, indexed by fog aggregator
+ * }
+ * </pre>
+ */
+enum CloudPort {
+    PORT_NONE = 0,
+    PORT_HOST = 1,
+    PORT_CAN = 2,
+    PORT_FOG = 3
+};
+
+inline void doParsimPacking(omnetpp::cCommBuffer *b, const CloudPort& e) { b->pack(static_cast<int>(e)); }
+inline void doParsimUnpacking(omnetpp::cCommBuffer *b, CloudPort& e) { int n; b->unpack(n); e = static_cast<CloudPort>(n); }
+
+/**
+ * Class generated from <tt>garbage_collection/messages.msg:90</tt> by opp_msgtool.
+ * <pre>
+ * // Carries a packet between the CloudRouter and a cloud shard, together with
+ * // the router port it arrived on or has to leave by, so that the shard sees the
+ * // same arrival gates as an unsharded cloud. The packet is encapsulated.
+ * packet ShardEnvelope extends GarbagePacket
+ * {
+ *     int port = PORT_NONE;   // a CloudPort
+ *     int portIndex = -1;
+ * }
+ * </pre>
+ */
+class ShardEnvelope : public ::garbage_collection::GarbagePacket
+{
+  protected:
+    int port = PORT_NONE;
+    int portIndex = -1;
+
+  private:
+    void copy(const ShardEnvelope& other);
+
+  protected:
+    bool operator==(const ShardEnvelope&) = delete;
+
+  public:
+    ShardEnvelope(const char *name=nullptr, short kind=0);
+    ShardEnvelope(const ShardEnvelope& other);
+    virtual ~ShardEnvelope();
+    ShardEnvelope& operator=(const ShardEnvelope& other);
+    virtual ShardEnvelope *dup() const override {return new ShardEnvelope(*this);}
+    virtual void parsimPack(omnetpp::cCommBuffer *b) const override;
+    virtual void parsimUnpack(omnetpp::cCommBuffer *b) override;
+
+    virtual int getPort() const;
+    virtual void setPort(int port);
+
+    virtual int getPortIndex() const;
+    virtual void setPortIndex(int portIndex);
+};
+
+inline void doParsimPacking(omnetpp::cCommBuffer *b, const ShardEnvelope& obj) {obj.parsimPack(b);}
+inline void doParsimUnpacking(omnetpp::cCommBuffer *b, ShardEnvelope& obj) {obj.parsimUnpack(b);}
+
 
 }  // namespace garbage_collection
 
@@ -89,6 +429,11 @@ inline void doParsimUnpacking(omnetpp::cCommBuffer *b, GarbagePacket& obj) {obj.
 namespace omnetpp {
 
 template<> inline garbage_collection::GarbagePacket *fromAnyPtr(any_ptr ptr) { return check_and_cast<garbage_collection::GarbagePacket*>(ptr.get<cObject>()); }
+template<> inline garbage_collection::CanTimer *fromAnyPtr(any_ptr ptr) { return check_and_cast<garbage_collection::CanTimer*>(ptr.get<cObject>()); }
+template<> inline garbage_collection::CollectTimer *fromAnyPtr(any_ptr ptr) { return check_and_cast<garbage_collection::CollectTimer*>(ptr.get<cObject>()); }
+template<> inline garbage_collection::FogSummary *fromAnyPtr(any_ptr ptr) { return check_and_cast<garbage_collection::FogSummary*>(ptr.get<cObject>()); }
+template<> inline garbage_collection::WorkSteal *fromAnyPtr(any_ptr ptr) { return check_and_cast<garbage_collection::WorkSteal*>(ptr.get<cObject>()); }
+template<> inline garbage_collection::ShardEnvelope *fromAnyPtr(any_ptr ptr) { return check_and_cast<garbage_collection::ShardEnvelope*>(ptr.get<cObject>()); }
 
 }  // namespace omnetpp
 
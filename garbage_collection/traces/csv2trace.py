@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""Converts a CSV of per-can fill events into the binary FillTrace format.
+
+Input rows are "can,time,kind,value" with an optional header line. time is in
+seconds of simulation time, kind is one of:
+
+  rate     the can fills at value litres per hour from time on
+  deposit  value litres are thrown in at time
+  level    a sensor reading of value litres; a rise since the can's previous
+           reading becomes a deposit, a drop (the bin was emptied outside the
+           simulation) is skipped
+
+Rows may come in any order; they are grouped by can and sorted by time.
+
+    python3 csv2trace.py bins.csv bins.trace [--cans N]
+"""
+
+import argparse
+import csv
+import struct
+import sys
+from collections import defaultdict
+
+MAGIC = b"GCTRACE1"
+VERSION = 1
+EVENT_FILL_RATE = 1
+EVENT_DEPOSIT = 2
+EVENT = struct.Struct("=ddII")
+
+
+def read_events(path):
+    rows = defaultdict(list)
+    with open(path, newline="") as source:
+        for line, row in enumerate(csv.reader(source), 1):
+            if not row or row[0].startswith("#"):
+                continue
+            if line == 1 and row[0].strip() == "can":
+                continue
+            can, time, kind, value = row
+            rows[int(can)].append((float(time), kind.strip(), float(value), line))
+
+    events = {}
+    for can, readings in rows.items():
+        readings.sort(key=lambda reading: reading[0])
+        converted = []
+        level = None
+        for time, kind, value, line in readings:
+            if time < 0:
+                sys.exit("%s:%d: time must not be negative" % (path, line))
+            if kind == "rate":
+                converted.append((time, value, EVENT_FILL_RATE))
+            elif kind == "deposit":
+                converted.append((time, value, EVENT_DEPOSIT))
+            elif kind == "level":
+                if level is not None and value > level:
+                    converted.append((time, value - level, EVENT_DEPOSIT))
+                level = value
+            else:
+                sys.exit("%s:%d: unknown kind '%s' (expected rate, deposit or level)" % (path, line, kind))
+        events[can] = converted
+    return events
+
+
+def write_trace(path, events, num_cans):
+    with open(path, "wb") as target:
+        target.write(MAGIC + struct.pack("=II", VERSION, num_cans))
+        position = 0
+        for can in range(num_cans):
+            target.write(struct.pack("=Q", position))
+            position += len(events.get(can, ()))
+        target.write(struct.pack("=Q", position))
+        for can in range(num_cans):
+            for time, value, kind in events.get(can, ()):
+                target.write(EVENT.pack(time, value, kind, 0))
+    return position
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("csv")
+    parser.add_argument("trace")
+    parser.add_argument("--cans", type=int, help="fleet size (default: highest can id + 1)")
+    args = parser.parse_args()
+
+    events = read_events(args.csv)
+    num_cans = args.cans if args.cans is not None else max(events, default=-1) + 1
+    if events and max(events) >= num_cans:
+        sys.exit("can %d is outside a fleet of %d cans" % (max(events), num_cans))
+    count = write_trace(args.trace, events, num_cans)
+    print("%s: %d events for %d cans" % (args.trace, count, num_cans))
+
+
+if __name__ == "__main__":
+    main()